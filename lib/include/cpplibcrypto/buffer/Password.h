@@ -42,6 +42,8 @@ public:
 
     Size size() const { return mData.size(); }
 
+    const Byte* data() const { return mData.data(); }
+
     Iterator begin() { return mData.begin(); }
 
     Iterator end() { return mData.end(); }
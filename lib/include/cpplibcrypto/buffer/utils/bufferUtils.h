@@ -3,6 +3,8 @@
 
 #include "cpplibcrypto/common/common.h"
 
+#include <cstring>
+
 namespace crypto::bufferUtils {
 
 /// Applies an XOR operation on the given container with the given source
@@ -30,6 +32,27 @@ constexpr inline void xorBuffer(TIterator first, TIterator last, TConstIterator
     }
 }
 
+/// XORs two byte arrays into the output array
+///
+/// Works on whole Qwords where possible, which the compiler can further vectorise.
+/// \param out The output, may be the same as \p lhs or \p rhs, but must not overlap them otherwise
+/// \param lhs The first operand
+/// \param rhs The second operand
+/// \param size The number of bytes to XOR
+inline void xorBytes(Byte* out, const Byte* lhs, const Byte* rhs, const Size size) {
+    Size i = 0;
+    for (; i + sizeof(Qword) <= size; i += sizeof(Qword)) {
+        Qword a, b;
+        std::memcpy(&a, lhs + i, sizeof(Qword));
+        std::memcpy(&b, rhs + i, sizeof(Qword));
+        a ^= b;
+        std::memcpy(out + i, &a, sizeof(Qword));
+    }
+    for (; i < size; ++i) {
+        out[i] = lhs[i] ^ rhs[i];
+    }
+}
+
 /// Pushes an XORed data to the given container
 ///
 /// \param container The container to push to
@@ -4,9 +4,12 @@
 #include "cpplibcrypto/cipher/BlockCipherSized.h"
 
 #include "cpplibcrypto/buffer/DynamicBuffer.h"
+#include "cpplibcrypto/cipher/AesBitsliced.h"
 #include "cpplibcrypto/cipher/AesCore.h"
 #include "cpplibcrypto/cipher/AesIv.h"
 #include "cpplibcrypto/cipher/AesKey.h"
+#include "cpplibcrypto/cipher/AesNi.h"
+#include "cpplibcrypto/cipher/AesTTable.h"
 #include "cpplibcrypto/common/Exception.h"
 #include "cpplibcrypto/common/common.h"
 
@@ -15,6 +18,12 @@
 namespace crypto {
 
 /// AES algorithm implementation in all common key sizes (128, 192, 256 bits)
+///
+/// The rounds are computed by the AES-NI instructions, by the constant-time bitsliced SSSE3 implementation or
+/// by the portable lookup table implementation. Unless requested otherwise, AES-NI is used whenever the CPU
+/// supports it, falling back to the lookup tables. The bitsliced implementation doesn't leak the key through
+/// cache timing like the lookup tables do, but a single block costs as much as eight, so it has to be
+/// requested explicitly. It suits bulk modes such as CTR or GCM.
 class Aes : public BlockCipherSized<16> {
 public:
     static constexpr Size Aes128 = 16;
@@ -23,12 +32,49 @@ public:
     using Key = AesKey;
     using Iv = AesIv;
 
-    Aes() = default;
+    /// Implementation of the AES rounds
+    enum class Implementation {
+        /// Portable implementation using lookup tables, see \ref AesTTable
+        TTable,
+        /// Hardware implementation using the AES-NI instructions, see \ref AesNi
+        AesNi,
+        /// Constant-time implementation processing eight blocks at once, see \ref AesBitsliced
+        Bitsliced,
+    };
 
-    explicit Aes(const AesKey& key) { setKey(key); }
+    Aes()
+        : mImplementation(getDefaultImplementation()) {}
+
+    explicit Aes(const AesKey& key)
+        : Aes() {
+        setKey(key);
+    }
+
+    /// Creates the cipher using the given implementation
+    /// \throws Exception if the implementation is not supported on this CPU
+    explicit Aes(const Implementation implementation)
+        : mImplementation(implementation) {
+        if (!isSupported(implementation)) {
+            throw Exception("AES: Implementation not supported on this CPU");
+        }
+    }
+
+    /// Creates the cipher using the given implementation and performs the key schedule
+    /// \throws Exception if the implementation is not supported on this CPU
+    Aes(const AesKey& key, const Implementation implementation)
+        : Aes(implementation) {
+        setKey(key);
+    }
 
     Aes& operator=(Aes&& other) {
+        mKeySize = other.mKeySize;
+        mImplementation = other.mImplementation;
+        mRounds = other.mRounds;
         mRoundKeys = std::move(other.mRoundKeys);
+        std::swap(mInvRoundKeys, other.mInvRoundKeys);
+        std::swap(mEncKeys, other.mEncKeys);
+        std::swap(mDecKeys, other.mDecKeys);
+        std::swap(mBitslicedKeys, other.mBitslicedKeys);
         return *this;
     }
 
@@ -42,11 +88,14 @@ public:
     /// \throws Exception if \ref AesKey is not set
     void encryptBlock(ByteBufferSlice buffer) const override {
         ASSERT(buffer.size() == getBlockSize());
-        processFirstRound(buffer);
-        for (Byte i = 0; i < getNumberOfRounds() - 1; ++i) {
-            processRound(buffer, i);
+        if (mImplementation == Implementation::AesNi) {
+            AesNi::encryptBlock(mRoundKeys.data(), getNumberOfRounds(), buffer.data(), buffer.data());
+        } else if (mImplementation == Implementation::Bitsliced) {
+            AesBitsliced::encryptBlocks(
+                mBitslicedKeys.data(), getNumberOfRounds(), buffer.data(), buffer.data(), 1);
+        } else {
+            AesTTable::encryptBlock(mEncKeys.data(), getNumberOfRounds(), buffer.data(), buffer.data());
         }
-        processLastRound(buffer);
     }
 
     /// Encrypts one block
@@ -57,44 +106,78 @@ public:
     /// \throws Exception if \ref AesKey is not set
     void decryptBlock(ByteBufferSlice buffer) const override {
         ASSERT(buffer.size() == getBlockSize());
-        processFirstRoundInv(buffer);
-        for (Byte i = getNumberOfRounds() - 1; i >= 1; --i) {
-            processRoundInv(buffer, i);
+        if (mImplementation == Implementation::AesNi) {
+            AesNi::decryptBlock(mInvRoundKeys.data(), getNumberOfRounds(), buffer.data(), buffer.data());
+        } else if (mImplementation == Implementation::Bitsliced) {
+            AesBitsliced::decryptBlocks(
+                mBitslicedKeys.data(), getNumberOfRounds(), buffer.data(), buffer.data(), 1);
+        } else {
+            AesTTable::decryptBlock(mDecKeys.data(), getNumberOfRounds(), buffer.data(), buffer.data());
         }
-        processLastRoundInv(buffer);
     }
 
-protected:
-    void processFirstRound(ByteBufferSlice buffer) const { AesCore::addRoundKey(buffer, mRoundKeys, 0); }
-
-    void processRound(ByteBufferSlice buffer, const Byte round) const {
-        AesCore::subBytes(buffer);
-        AesCore::shiftRows(buffer);
-        AesCore::mixColumns(buffer);
-        AesCore::addRoundKey(buffer, mRoundKeys, round + 1);
+    /// Encrypts consecutive blocks
+    ///
+    /// With AES-NI, eight blocks are processed in parallel to hide the latency of the AES instructions. The
+    /// bitsliced implementation computes eight blocks in one pass as well.
+    /// \throws Exception if \ref AesKey is not set
+    void encryptBlocks(const Byte* in, Byte* out, const Size nBlocks) const override {
+        const Byte rounds = getNumberOfRounds();
+        if (mImplementation == Implementation::AesNi) {
+            AesNi::encryptBlocks(mRoundKeys.data(), rounds, in, out, nBlocks);
+        } else if (mImplementation == Implementation::Bitsliced) {
+            AesBitsliced::encryptBlocks(mBitslicedKeys.data(), rounds, in, out, nBlocks);
+        } else {
+            for (Size i = 0; i < nBlocks; ++i) {
+                AesTTable::encryptBlock(mEncKeys.data(), rounds, in + 16 * i, out + 16 * i);
+            }
+        }
     }
 
-    void processLastRound(ByteBufferSlice buffer) const {
-        AesCore::subBytes(buffer);
-        AesCore::shiftRows(buffer);
-        AesCore::addRoundKey(buffer, mRoundKeys, getNumberOfRounds());
+    /// Decrypts consecutive blocks
+    ///
+    /// With AES-NI, eight blocks are processed in parallel to hide the latency of the AES instructions. The
+    /// bitsliced implementation computes eight blocks in one pass as well.
+    /// \throws Exception if \ref AesKey is not set
+    void decryptBlocks(const Byte* in, Byte* out, const Size nBlocks) const override {
+        const Byte rounds = getNumberOfRounds();
+        if (mImplementation == Implementation::AesNi) {
+            AesNi::decryptBlocks(mInvRoundKeys.data(), rounds, in, out, nBlocks);
+        } else if (mImplementation == Implementation::Bitsliced) {
+            AesBitsliced::decryptBlocks(mBitslicedKeys.data(), rounds, in, out, nBlocks);
+        } else {
+            for (Size i = 0; i < nBlocks; ++i) {
+                AesTTable::decryptBlock(mDecKeys.data(), rounds, in + 16 * i, out + 16 * i);
+            }
+        }
     }
 
-    void processFirstRoundInv(ByteBufferSlice buffer) const {
-        AesCore::addRoundKey(buffer, mRoundKeys, getNumberOfRounds());
-        AesCore::shiftRowsInv(buffer);
-        AesCore::subBytesInv(buffer);
-    }
+    /// Returns the implementation used by this instance
+    Implementation getImplementation() const { return mImplementation; }
 
-    void processRoundInv(ByteBufferSlice buffer, const Byte round) const {
-        AesCore::addRoundKey(buffer, mRoundKeys, round);
-        AesCore::mixColumnsInv(buffer);
-        AesCore::shiftRowsInv(buffer);
-        AesCore::subBytesInv(buffer);
+    /// Returns true if the given implementation can be used on this CPU
+    static bool isSupported(const Implementation implementation) {
+        switch (implementation) {
+        case Implementation::AesNi:
+            return AesNi::isSupported();
+        case Implementation::Bitsliced:
+            return AesBitsliced::isSupported();
+        case Implementation::TTable:
+            break;
+        }
+        return true;
     }
 
-    void processLastRoundInv(ByteBufferSlice buffer) const { AesCore::addRoundKey(buffer, mRoundKeys, 0); }
+    /// Returns AES-NI if supported on this CPU, the lookup tables otherwise
+    ///
+    /// The bitsliced implementation is never the default, its single-block calls are several times slower
+    /// than the lookup tables.
+    static Implementation getDefaultImplementation() {
+        return AesNi::isSupported() ? Implementation::AesNi : Implementation::TTable;
+    }
 
+protected:
+    /// Key schedule as defined by FIPS-197, section 5.2
     ByteBuffer mRoundKeys;
 
 private:
@@ -113,8 +196,17 @@ private:
         throw Exception("AES: Key not set");
     }
 
+    /// Returns the number of rounds of the current key
+    /// \throws Exception if \ref AesKey is not set
     Byte getNumberOfRounds() const {
-        switch (getKeySize()) {
+        if (mRounds == 0) {
+            throw Exception("AES: Key not set");
+        }
+        return mRounds;
+    }
+
+    static Byte getNumberOfRounds(const Size keySize) {
+        switch (keySize) {
         case Aes128:
             return 10;
         case Aes192:
@@ -122,10 +214,12 @@ private:
         case Aes256:
             return 14;
         }
-        throw Exception("AES: Key not set");
+        throw Exception("AES: Invalid key size");
     }
 
     void keySchedule(const ConstByteBufferSlice& key) override {
+        mRounds = getNumberOfRounds(key.size());
+        mRoundKeys.clear();
         mRoundKeys.insert(mRoundKeys.end(), key.begin(), key.end());
         Byte rconIteration = 0;
         while (mRoundKeys.size() < getExpandedKeySize()) {
@@ -144,7 +238,29 @@ private:
                 mRoundKeys << (mRoundKeys[mRoundKeys.size() - getKeySize()] ^ word32[i]);
             }
         }
+
+        // The implementations need their own form of the key schedule derived from the encryption one, do it
+        // once here rather than on every block
+        if (mImplementation == Implementation::AesNi) {
+            mInvRoundKeys.resize(mRoundKeys.size());
+            AesNi::expandDecryptionKey(mRoundKeys.data(), mRounds, mInvRoundKeys.data());
+        } else if (mImplementation == Implementation::Bitsliced) {
+            mBitslicedKeys.resize(AesBitsliced::ROUND_KEY_SIZE * (mRounds + 1));
+            AesBitsliced::expandKey(mRoundKeys.data(), mRounds, mBitslicedKeys.data());
+        } else {
+            const Size words = 4 * (mRounds + 1);
+            mEncKeys.resize(words);
+            mDecKeys.resize(words);
+            AesTTable::expandKey(mRoundKeys, mRounds, mEncKeys.data(), mDecKeys.data());
+        }
     }
+
+    Implementation mImplementation;
+    Byte mRounds = 0;
+    StaticBuffer<Byte, AesNi::MAX_EXPANDED_KEY_SIZE> mInvRoundKeys;
+    StaticBuffer<Dword, AesTTable::MAX_ROUND_KEY_WORDS> mEncKeys;
+    StaticBuffer<Dword, AesTTable::MAX_ROUND_KEY_WORDS> mDecKeys;
+    StaticBuffer<Byte, AesBitsliced::MAX_EXPANDED_KEY_SIZE> mBitslicedKeys;
 };
 
 } // namespace crypto
@@ -0,0 +1,65 @@
+#ifndef CPPLIBCRYPTO_CIPHER_AESBITSLICED_H_
+#define CPPLIBCRYPTO_CIPHER_AESBITSLICED_H_
+
+#include "cpplibcrypto/common/common.h"
+
+namespace crypto {
+
+/// Constant-time AES implementation processing eight blocks at once in bitsliced form
+///
+/// The eight blocks are transposed into eight 128-bit SSE registers, register i holding bit i of every byte
+/// of all the blocks (Kasper and Schwabe, "Faster and Timing-Attack Resistant AES-GCM"). SubBytes is
+/// evaluated as a boolean circuit (Boyar and Peralta), ShiftRows is a byte shuffle and MixColumns rotates and
+/// XORs whole registers. There are no secret dependent memory accesses or branches, unlike in the lookup
+/// table implementations. Fewer than eight blocks still cost a full pass, so it pays off for bulk data.
+///
+/// None of the methods but \ref isSupported() and \ref expandKey() may be called unless \ref isSupported()
+/// returns true.
+class AesBitsliced final {
+public:
+    /// Number of blocks processed at once
+    static constexpr Size LANES = 8;
+
+    /// The size of one bitsliced round key
+    static constexpr Size ROUND_KEY_SIZE = 128;
+
+    /// The size of the bitsliced key schedule of the largest (256-bit) key
+    static constexpr Size MAX_EXPANDED_KEY_SIZE = 15 * ROUND_KEY_SIZE;
+
+    /// Returns true if the library was built with SSSE3 support and the CPU supports it
+    static bool isSupported();
+
+    /// Converts the byte key schedule to the bitsliced one
+    ///
+    /// Every round key byte is spread over the eight registers, the same for all the blocks. The same key
+    /// schedule serves for both the encryption and the decryption.
+    /// \param roundKeys The key schedule as produced by the AES key expansion, 16 * (rounds + 1) bytes
+    /// \param rounds The number of rounds (10, 12 or 14)
+    /// \param keys Output for the bitsliced key schedule, must hold ROUND_KEY_SIZE * (rounds + 1) bytes
+    static void expandKey(const Byte* roundKeys, Byte rounds, Byte* keys);
+
+    /// Encrypts consecutive blocks
+    ///
+    /// \param keys The bitsliced key schedule produced by \ref expandKey()
+    /// \param rounds The number of rounds (10, 12 or 14)
+    /// \param in The plaintext, 16 * nBlocks bytes
+    /// \param out Output for the ciphertext. May be the same as \p in
+    /// \param nBlocks The number of blocks
+    static void encryptBlocks(const Byte* keys, Byte rounds, const Byte* in, Byte* out, Size nBlocks);
+
+    /// Decrypts consecutive blocks
+    ///
+    /// \param keys The bitsliced key schedule produced by \ref expandKey()
+    /// \param rounds The number of rounds (10, 12 or 14)
+    /// \param in The ciphertext, 16 * nBlocks bytes
+    /// \param out Output for the plaintext. May be the same as \p in
+    /// \param nBlocks The number of blocks
+    static void decryptBlocks(const Byte* keys, Byte rounds, const Byte* in, Byte* out, Size nBlocks);
+
+private:
+    AesBitsliced() = delete;
+};
+
+} // namespace crypto
+
+#endif // CPPLIBCRYPTO_CIPHER_AESBITSLICED_H_
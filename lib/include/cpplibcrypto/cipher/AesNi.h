@@ -0,0 +1,71 @@
+#ifndef CPPLIBCRYPTO_CIPHER_AESNI_H_
+#define CPPLIBCRYPTO_CIPHER_AESNI_H_
+
+#include "cpplibcrypto/common/common.h"
+
+namespace crypto {
+
+/// AES implementation using the AES-NI instruction set extension
+///
+/// The encryption key schedule is the byte key schedule as defined by FIPS-197, each round key is loaded as
+/// one 128-bit word. Decryption follows the equivalent inverse cipher whose key schedule is produced by
+/// \ref expandDecryptionKey(). None of the methods but \ref isSupported() may be called unless \ref
+/// isSupported() returns true.
+class AesNi final {
+public:
+    /// The size of the key schedule of the largest (256-bit) key
+    static constexpr Size MAX_EXPANDED_KEY_SIZE = 240;
+
+    /// Returns true if the library was built with AES-NI support and the CPU supports it
+    static bool isSupported();
+
+    /// Computes the decryption key schedule from the encryption one
+    ///
+    /// The round keys are reversed and AESIMC (InvMixColumns) is applied to all but the first and the last
+    /// one.
+    /// \param encKeys The encryption key schedule, 16 * (rounds + 1) bytes
+    /// \param rounds The number of rounds (10, 12 or 14)
+    /// \param decKeys Output for the decryption key schedule, must hold 16 * (rounds + 1) bytes
+    static void expandDecryptionKey(const Byte* encKeys, Byte rounds, Byte* decKeys);
+
+    /// Encrypts one 16 byte block
+    ///
+    /// \param encKeys The encryption key schedule
+    /// \param rounds The number of rounds (10, 12 or 14)
+    /// \param in The plaintext block
+    /// \param out The output ciphertext block. May be the same as \p in
+    static void encryptBlock(const Byte* encKeys, Byte rounds, const Byte* in, Byte* out);
+
+    /// Decrypts one 16 byte block
+    ///
+    /// \param decKeys The decryption key schedule produced by \ref expandDecryptionKey()
+    /// \param rounds The number of rounds (10, 12 or 14)
+    /// \param in The ciphertext block
+    /// \param out The output plaintext block. May be the same as \p in
+    static void decryptBlock(const Byte* decKeys, Byte rounds, const Byte* in, Byte* out);
+
+    /// Encrypts consecutive blocks, eight of them at a time
+    ///
+    /// \param encKeys The encryption key schedule
+    /// \param rounds The number of rounds (10, 12 or 14)
+    /// \param in The plaintext, 16 * nBlocks bytes
+    /// \param out Output for the ciphertext. May be the same as \p in
+    /// \param nBlocks The number of blocks
+    static void encryptBlocks(const Byte* encKeys, Byte rounds, const Byte* in, Byte* out, Size nBlocks);
+
+    /// Decrypts consecutive blocks, eight of them at a time
+    ///
+    /// \param decKeys The decryption key schedule produced by \ref expandDecryptionKey()
+    /// \param rounds The number of rounds (10, 12 or 14)
+    /// \param in The ciphertext, 16 * nBlocks bytes
+    /// \param out Output for the plaintext. May be the same as \p in
+    /// \param nBlocks The number of blocks
+    static void decryptBlocks(const Byte* decKeys, Byte rounds, const Byte* in, Byte* out, Size nBlocks);
+
+private:
+    AesNi() = delete;
+};
+
+} // namespace crypto
+
+#endif // CPPLIBCRYPTO_CIPHER_AESNI_H_
@@ -0,0 +1,167 @@
+#ifndef CPPLIBCRYPTO_CIPHER_AESTTABLE_H_
+#define CPPLIBCRYPTO_CIPHER_AESTTABLE_H_
+
+#include "cpplibcrypto/buffer/DynamicBuffer.h"
+#include "cpplibcrypto/cipher/AesCore.h"
+#include "cpplibcrypto/common/bitManip.h"
+#include "cpplibcrypto/common/common.h"
+
+namespace crypto {
+
+/// Combined AES round lookup tables, see \ref makeAesRoundTables()
+struct AesRoundTables {
+    Dword te[4][256];
+    Dword td[4][256];
+};
+
+/// Builds the round tables from the S-boxes and the GF(2^8) multiplication tables
+///
+/// Te0[x] holds the MixColumns column (2, 1, 1, 3) * S(x), Td0[x] holds (14, 9, 13, 11) * S^-1(x). The
+/// remaining tables are the same columns rotated by one byte each.
+constexpr AesRoundTables makeAesRoundTables() {
+    AesRoundTables tables{};
+    for (Size i = 0; i < 256; ++i) {
+        const Byte s = sbox[i];
+        const Byte si = sboxinv[i];
+        tables.te[0][i] = (Dword(mul2[s]) << 24) | (Dword(s) << 16) | (Dword(s) << 8) | Dword(mul3[s]);
+        tables.td[0][i] =
+            (Dword(mul14[si]) << 24) | (Dword(mul9[si]) << 16) | (Dword(mul13[si]) << 8) | Dword(mul11[si]);
+        for (Byte t = 1; t < 4; ++t) {
+            tables.te[t][i] = bits::rotateRight(tables.te[0][i], 8 * t);
+            tables.td[t][i] = bits::rotateRight(tables.td[0][i], 8 * t);
+        }
+    }
+    return tables;
+}
+
+inline constexpr AesRoundTables aesRoundTables = makeAesRoundTables();
+
+/// Word-oriented AES implementation
+///
+/// SubBytes, ShiftRows and MixColumns are merged into four 32-bit lookup tables per direction, so a full
+/// round costs 16 table lookups and the state lives in four Dwords. Round keys are stored as big-endian
+/// Dwords. Decryption follows the equivalent inverse cipher (FIPS-197, section 5.3.5) which requires its own
+/// key schedule, see \ref expandKey().
+class AesTTable final {
+public:
+    /// The number of Dwords needed to hold the key schedule of the largest (256-bit) key
+    static constexpr Size MAX_ROUND_KEY_WORDS = 60;
+
+    /// Converts the byte key schedule to the encryption and decryption Dword key schedules
+    ///
+    /// \param roundKeys The key schedule as produced by the AES key expansion
+    /// \param rounds The number of rounds (10, 12 or 14)
+    /// \param encKeys Output for the encryption key schedule, must hold 4 * (rounds + 1) words
+    /// \param decKeys Output for the equivalent inverse cipher key schedule, must hold 4 * (rounds + 1) words
+    static void expandKey(const ByteBuffer& roundKeys, const Byte rounds, Dword* encKeys, Dword* decKeys) {
+        const Size words = 4 * (rounds + 1);
+        ASSERT(roundKeys.size() == 4 * words);
+        for (Size i = 0; i < words; ++i) {
+            encKeys[i] = bits::loadBigEndian<Dword>(roundKeys.data() + 4 * i);
+        }
+
+        // The decryption schedule runs backwards and has InvMixColumns applied to all but the first and the
+        // last round key
+        for (Size round = 0; round <= rounds; ++round) {
+            for (Size i = 0; i < 4; ++i) {
+                const Dword w = encKeys[4 * (rounds - round) + i];
+                if (round == 0 || round == rounds) {
+                    decKeys[4 * round + i] = w;
+                } else {
+                    // Td tables contain the inverse S-box, feeding them the S-box output cancels it out
+                    const auto& td = aesRoundTables.td;
+                    decKeys[4 * round + i] = td[0][sbox[w >> 24]] ^ td[1][sbox[(w >> 16) & 0xff]] ^
+                                             td[2][sbox[(w >> 8) & 0xff]] ^ td[3][sbox[w & 0xff]];
+                }
+            }
+        }
+    }
+
+    /// Encrypts one 16 byte block
+    ///
+    /// \param encKeys The encryption key schedule produced by \ref expandKey()
+    /// \param rounds The number of rounds (10, 12 or 14)
+    /// \param in The plaintext block
+    /// \param out The output ciphertext block. May be the same as \p in
+    static void encryptBlock(const Dword* encKeys, const Byte rounds, const Byte* in, Byte* out) {
+        const auto& te = aesRoundTables.te;
+        const Dword* rk = encKeys;
+        Dword s0 = bits::loadBigEndian<Dword>(in) ^ rk[0];
+        Dword s1 = bits::loadBigEndian<Dword>(in + 4) ^ rk[1];
+        Dword s2 = bits::loadBigEndian<Dword>(in + 8) ^ rk[2];
+        Dword s3 = bits::loadBigEndian<Dword>(in + 12) ^ rk[3];
+
+        for (Byte round = 1; round < rounds; ++round) {
+            rk += 4;
+            const Dword t0 = te[0][s0 >> 24] ^ te[1][(s1 >> 16) & 0xff] ^ te[2][(s2 >> 8) & 0xff] ^
+                             te[3][s3 & 0xff] ^ rk[0];
+            const Dword t1 = te[0][s1 >> 24] ^ te[1][(s2 >> 16) & 0xff] ^ te[2][(s3 >> 8) & 0xff] ^
+                             te[3][s0 & 0xff] ^ rk[1];
+            const Dword t2 = te[0][s2 >> 24] ^ te[1][(s3 >> 16) & 0xff] ^ te[2][(s0 >> 8) & 0xff] ^
+                             te[3][s1 & 0xff] ^ rk[2];
+            const Dword t3 = te[0][s3 >> 24] ^ te[1][(s0 >> 16) & 0xff] ^ te[2][(s1 >> 8) & 0xff] ^
+                             te[3][s2 & 0xff] ^ rk[3];
+            s0 = t0;
+            s1 = t1;
+            s2 = t2;
+            s3 = t3;
+        }
+
+        // The last round has no MixColumns step
+        rk += 4;
+        bits::storeBigEndian(out, lastRound(sbox, s0, s1, s2, s3) ^ rk[0]);
+        bits::storeBigEndian(out + 4, lastRound(sbox, s1, s2, s3, s0) ^ rk[1]);
+        bits::storeBigEndian(out + 8, lastRound(sbox, s2, s3, s0, s1) ^ rk[2]);
+        bits::storeBigEndian(out + 12, lastRound(sbox, s3, s0, s1, s2) ^ rk[3]);
+    }
+
+    /// Decrypts one 16 byte block
+    ///
+    /// \param decKeys The decryption key schedule produced by \ref expandKey()
+    /// \param rounds The number of rounds (10, 12 or 14)
+    /// \param in The ciphertext block
+    /// \param out The output plaintext block. May be the same as \p in
+    static void decryptBlock(const Dword* decKeys, const Byte rounds, const Byte* in, Byte* out) {
+        const auto& td = aesRoundTables.td;
+        const Dword* rk = decKeys;
+        Dword s0 = bits::loadBigEndian<Dword>(in) ^ rk[0];
+        Dword s1 = bits::loadBigEndian<Dword>(in + 4) ^ rk[1];
+        Dword s2 = bits::loadBigEndian<Dword>(in + 8) ^ rk[2];
+        Dword s3 = bits::loadBigEndian<Dword>(in + 12) ^ rk[3];
+
+        for (Byte round = 1; round < rounds; ++round) {
+            rk += 4;
+            const Dword t0 = td[0][s0 >> 24] ^ td[1][(s3 >> 16) & 0xff] ^ td[2][(s2 >> 8) & 0xff] ^
+                             td[3][s1 & 0xff] ^ rk[0];
+            const Dword t1 = td[0][s1 >> 24] ^ td[1][(s0 >> 16) & 0xff] ^ td[2][(s3 >> 8) & 0xff] ^
+                             td[3][s2 & 0xff] ^ rk[1];
+            const Dword t2 = td[0][s2 >> 24] ^ td[1][(s1 >> 16) & 0xff] ^ td[2][(s0 >> 8) & 0xff] ^
+                             td[3][s3 & 0xff] ^ rk[2];
+            const Dword t3 = td[0][s3 >> 24] ^ td[1][(s2 >> 16) & 0xff] ^ td[2][(s1 >> 8) & 0xff] ^
+                             td[3][s0 & 0xff] ^ rk[3];
+            s0 = t0;
+            s1 = t1;
+            s2 = t2;
+            s3 = t3;
+        }
+
+        rk += 4;
+        bits::storeBigEndian(out, lastRound(sboxinv, s0, s3, s2, s1) ^ rk[0]);
+        bits::storeBigEndian(out + 4, lastRound(sboxinv, s1, s0, s3, s2) ^ rk[1]);
+        bits::storeBigEndian(out + 8, lastRound(sboxinv, s2, s1, s0, s3) ^ rk[2]);
+        bits::storeBigEndian(out + 12, lastRound(sboxinv, s3, s2, s1, s0) ^ rk[3]);
+    }
+
+private:
+    AesTTable() = delete;
+
+    /// Computes one output column of the last round, taking row i from the i-th given word
+    static Dword lastRound(const Byte* box, const Dword w0, const Dword w1, const Dword w2, const Dword w3) {
+        return (Dword(box[w0 >> 24]) << 24) | (Dword(box[(w1 >> 16) & 0xff]) << 16) |
+               (Dword(box[(w2 >> 8) & 0xff]) << 8) | Dword(box[w3 & 0xff]);
+    }
+};
+
+} // namespace crypto
+
+#endif // CPPLIBCRYPTO_CIPHER_AESTTABLE_H_
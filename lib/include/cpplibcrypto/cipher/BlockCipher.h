@@ -6,6 +6,8 @@
 #include "cpplibcrypto/buffer/BufferSlice.h"
 #include "cpplibcrypto/common/Key.h"
 
+#include <algorithm>
+
 namespace crypto {
 
 /// Interface for block ciphers.
@@ -34,6 +36,42 @@ public:
     /// \param buffer The buffer which will get decrypted. Note that the buffer can be overwritten with the
     /// decrypted data.
     virtual void decryptBlock(ByteBufferSlice) const = 0;
+
+    /// Encrypts consecutive blocks
+    ///
+    /// The default implementation encrypts the blocks one by one. Ciphers able to process several blocks at
+    /// once should override it.
+    /// \param in The plaintext, nBlocks * getBlockSize() bytes
+    /// \param out Output for the ciphertext of the same size. May be the same as \p in, but must not overlap
+    /// it otherwise
+    /// \param nBlocks The number of blocks to encrypt
+    virtual void encryptBlocks(const Byte* in, Byte* out, const Size nBlocks) const {
+        const Size blockSize = getBlockSize();
+        if (in != out) {
+            std::copy(in, in + nBlocks * blockSize, out);
+        }
+        for (Size i = 0; i < nBlocks; ++i) {
+            encryptBlock(ByteBufferSlice(out + i * blockSize, out + (i + 1) * blockSize));
+        }
+    }
+
+    /// Decrypts consecutive blocks
+    ///
+    /// The default implementation decrypts the blocks one by one. Ciphers able to process several blocks at
+    /// once should override it.
+    /// \param in The ciphertext, nBlocks * getBlockSize() bytes
+    /// \param out Output for the plaintext of the same size. May be the same as \p in, but must not overlap
+    /// it otherwise
+    /// \param nBlocks The number of blocks to decrypt
+    virtual void decryptBlocks(const Byte* in, Byte* out, const Size nBlocks) const {
+        const Size blockSize = getBlockSize();
+        if (in != out) {
+            std::copy(in, in + nBlocks * blockSize, out);
+        }
+        for (Size i = 0; i < nBlocks; ++i) {
+            decryptBlock(ByteBufferSlice(out + i * blockSize, out + (i + 1) * blockSize));
+        }
+    }
 };
 
 } // namespace crypto
@@ -12,6 +12,8 @@
 #include "cpplibcrypto/common/common.h"
 #include "cpplibcrypto/padding/Padding.h"
 
+#include <algorithm>
+
 namespace crypto {
 
 /// Block cipher CBC decryptor
@@ -32,51 +34,95 @@ public:
 
     /// Decrypts the given input
     /// \param in The data to be decrypted
-    /// \param out A buffer to which the decrypted data will be pushed. The buffer is expected to have push()
-    /// and size() methods.
+    /// \param out A buffer to which the decrypted data will be pushed. The buffer is expected to have
+    /// insert() and size() methods.
     template <typename TBuffer>
     Size update(BufferSlice<const Byte> in, TBuffer& out) {
         const Size blockSize = mCipher.getBlockSize();
-        StaticBuffer<Byte, 16> buffer;
         ASSERT(mLeftoverBuffer.size() <= blockSize);
 
-        buffer.insert(buffer.end(), mLeftoverBuffer.begin(), mLeftoverBuffer.end());
-
-        // In case this is a full block, we will not decrypt it yet. We want to keep the last block for the
-        // final round so we can unpad the it.
-        const bool isFullBlock = ((buffer.size() + in.size()) % blockSize) == 0;
-        const Size numberOfBlocks = ((buffer.size() + in.size()) / blockSize) - int(isFullBlock);
+        // In case the data ends with a full block, we will not decrypt it yet. We want to keep the last block
+        // for the final round so we can unpad it.
+        const Size totalSize = mLeftoverBuffer.size() + in.size();
+        Size numberOfBlocks = totalSize / blockSize;
+        if (numberOfBlocks > 0 && totalSize % blockSize == 0) {
+            --numberOfBlocks;
+        }
 
-        // If there is some block we should prcess, we can be sure we will process the leftovers from last
-        // round (these leftovers are already in the buffer to decrypt) If there, however, isn't a block to
-        // process, we cannot clear it since we would throw away the already gathered, but unprocessed
-        // leftovers from previous rounds.
-        if (numberOfBlocks > 0) {
+        // The leftovers from the previous round have to be completed to a block first
+        Size processedInput = 0;
+        if (numberOfBlocks > 0 && !mLeftoverBuffer.empty()) {
+            processedInput = blockSize - mLeftoverBuffer.size();
+            mLeftoverBuffer.insert(mLeftoverBuffer.end(), in.begin(), in.begin() + processedInput);
+            decryptRun(mLeftoverBuffer.data(), 1, out);
             mLeftoverBuffer.clear();
+            --numberOfBlocks;
         }
 
-        Size processedInput = 0;
-        for (Size block = 0; block < numberOfBlocks; ++block) {
-            const Size toProcess = blockSize - buffer.size();
-            const Size blockStart = processedInput;
-            const Size blockEnd = blockStart + toProcess;
-
-            buffer.insert(buffer.end(), in.begin() + blockStart, in.begin() + blockEnd);
-            ASSERT(buffer.size() == blockSize);
-            StaticBuffer<Byte, 16> newIv;
-            newIv << buffer;
-            mCipher.decryptBlock(buffer);
-            bufferUtils::pushXored(out, buffer.cbegin(), buffer.cend(), mIv->cbegin());
-            processedInput += toProcess;
-            mIv->setNew(newIv.begin());
-            buffer.clear();
+        // The rest is aligned to the blocks and can be decrypted directly from the input
+        while (numberOfBlocks > 0) {
+            const Size runBlocks = std::min(numberOfBlocks, MAX_RUN_BLOCKS);
+            decryptRun(in.data() + processedInput, runBlocks, out);
+            processedInput += runBlocks * blockSize;
+            numberOfBlocks -= runBlocks;
         }
-        ASSERT(in.size() - processedInput <= blockSize);
+
+        ASSERT(mLeftoverBuffer.size() + in.size() - processedInput <= blockSize);
         mLeftoverBuffer.insert(mLeftoverBuffer.end(), in.begin() + processedInput, in.end());
 
         return out.size(); // return how many bytes were decrypted
     }
 
+    /// Decrypts the given input straight into the given output
+    /// \param in The data to be decrypted
+    /// \param out The output, must have room for all the blocks decrypted by this call. The last block is
+    /// always kept for \ref finalize(). May overlap \p in as long as it doesn't start after it, so a buffer
+    /// can be decrypted in place, also in chunks
+    /// \returns The number of bytes written to the output
+    /// \throws Exception in case the output is too small
+    Size update(BufferSlice<const Byte> in, BufferSlice<Byte> out) {
+        const Size blockSize = mCipher.getBlockSize();
+        const Size leftover = mLeftoverBuffer.size();
+        ASSERT(leftover <= blockSize);
+
+        const Size totalSize = leftover + in.size();
+        Size numberOfBlocks = totalSize / blockSize;
+        if (numberOfBlocks > 0 && totalSize % blockSize == 0) {
+            --numberOfBlocks;
+        }
+        if (out.size() < numberOfBlocks * blockSize) {
+            throw Exception("CBC-Mode: The output buffer is too small");
+        }
+
+        Byte ciphertext[MAX_RUN_BLOCKS * 16];
+        for (Size block = 0; block < numberOfBlocks;) {
+            const Size runBlocks = std::min(numberOfBlocks - block, MAX_RUN_BLOCKS);
+            const Size runSize = runBlocks * blockSize;
+            const Byte* input = in.data() + block * blockSize;
+            Byte* output = out.data() + block * blockSize;
+            if (leftover == 0 && (output + runSize <= input || output >= input + runSize)) {
+                decryptRun(input, runBlocks, output);
+            } else {
+                // The ciphertext is needed for the chaining after the output overwrites it. The output may
+                // also run ahead of the input by the size of the leftovers, so the input bytes the output run
+                // covers are moved to the leftover buffer before they can get overwritten.
+                std::copy(mLeftoverBuffer.data(), mLeftoverBuffer.data() + leftover, ciphertext);
+                std::copy(input, input + runSize - leftover, ciphertext + leftover);
+                const Byte* inputEnd = in.data() + std::min(in.size(), block * blockSize + runSize);
+                mLeftoverBuffer.clear();
+                mLeftoverBuffer.insert(mLeftoverBuffer.end(), input + runSize - leftover, inputEnd);
+                decryptRun(ciphertext, runBlocks, output);
+            }
+            block += runBlocks;
+        }
+
+        const Size processedInput = std::min(in.size(), numberOfBlocks * blockSize);
+        mLeftoverBuffer.insert(mLeftoverBuffer.end(), in.data() + processedInput, in.data() + in.size());
+        ASSERT(mLeftoverBuffer.size() <= blockSize);
+
+        return numberOfBlocks * blockSize;
+    }
+
     /// Removes padding
     template <typename TBuffer>
     void finalize(TBuffer& out, const Padding& padder) {
@@ -87,10 +133,54 @@ public:
         mLeftoverBuffer.clear();
     }
 
+    /// Removes padding and writes the rest of the last block straight into the given output
+    /// \param out The output, must have room for the unpadded last block
+    /// \returns The number of bytes written to the output
+    /// \throws Exception in case the output is too small
+    Size finalize(BufferSlice<Byte> out, const Padding& padder) {
+        StaticBuffer<Byte, 16> block;
+        finalize(block, padder);
+        if (out.size() < block.size()) {
+            throw Exception("CBC-Mode: The output buffer is too small");
+        }
+        std::copy(block.begin(), block.end(), out.begin());
+        return block.size();
+    }
+
     /// Resets the CB chain
     void resetChain() { mIv->reset(); }
 
 private:
+    /// The maximum number of blocks decrypted by one call to the cipher
+    static constexpr Size MAX_RUN_BLOCKS = 8;
+
+    /// Decrypts consecutive blocks and pushes the plaintext to the output
+    ///
+    /// Unlike encryption, CBC decryption has no dependency between the blocks. The whole run goes through the
+    /// bulk cipher interface and is then XORed with the IV and the preceding ciphertext blocks in one pass.
+    /// \param ciphertext The ciphertext, must stay valid until the call returns
+    /// \param blocks The number of blocks, at most \ref MAX_RUN_BLOCKS
+    template <typename TBuffer>
+    void decryptRun(const Byte* ciphertext, const Size blocks, TBuffer& out) {
+        Byte plaintext[MAX_RUN_BLOCKS * 16];
+        decryptRun(ciphertext, blocks, plaintext);
+        out.insert(out.end(), plaintext, plaintext + blocks * mCipher.getBlockSize());
+    }
+
+    /// Decrypts consecutive blocks into the given memory
+    /// \param ciphertext The ciphertext
+    /// \param blocks The number of blocks, at most \ref MAX_RUN_BLOCKS
+    /// \param plaintext Output for the plaintext, must not overlap \p ciphertext
+    void decryptRun(const Byte* ciphertext, const Size blocks, Byte* plaintext) {
+        ASSERT(blocks > 0 && blocks <= MAX_RUN_BLOCKS);
+        const Size blockSize = mCipher.getBlockSize();
+        mCipher.decryptBlocks(ciphertext, plaintext, blocks);
+        bufferUtils::xorBytes(plaintext, plaintext, mIv->data(), blockSize);
+        Byte* rest = plaintext + blockSize;
+        bufferUtils::xorBytes(rest, rest, ciphertext, (blocks - 1) * blockSize);
+        mIv->setNew(InitializationVector::ConstIterator(ciphertext + (blocks - 1) * blockSize));
+    }
+
     // Forbid temporary BlockCipher
     template <typename... TArgs>
     CbcDecrypt(const BlockCipher&& cipher, TArgs&&...) = delete;
@@ -12,6 +12,8 @@
 #include "cpplibcrypto/common/common.h"
 #include "cpplibcrypto/padding/Padding.h"
 
+#include <algorithm>
+
 namespace crypto {
 
 /// Block cipher CBC encryptor
@@ -70,6 +72,49 @@ public:
         return out.size(); // return how many bytes were encrypted
     }
 
+    /// Encrypts the given input straight into the given output
+    /// \param in The data to be encrypted
+    /// \param out The output, must have room for all the blocks completed by this call. May overlap \p in as
+    /// long as it doesn't start after it, so a buffer can be encrypted in place, also in chunks
+    /// \returns The number of bytes written to the output
+    /// \throws Exception in case the output is too small
+    Size update(BufferSlice<const Byte> in, BufferSlice<Byte> out) {
+        const Size blockSize = mCipher.getBlockSize();
+        const Size leftover = mLeftoverBuffer.size();
+        ASSERT(leftover < blockSize);
+        const Size numberOfBlocks = (leftover + in.size()) / blockSize;
+        if (out.size() < numberOfBlocks * blockSize) {
+            throw Exception("CBC-Mode: The output buffer is too small");
+        }
+
+        for (Size block = 0; block < numberOfBlocks; ++block) {
+            const Byte* input = in.data() + block * blockSize;
+            Byte* output = out.data() + block * blockSize;
+            if (leftover == 0) {
+                bufferUtils::xorBytes(output, input, mIv->data(), blockSize);
+            } else {
+                // The output may run ahead of the input by the size of the leftovers. The input bytes the
+                // output block covers are moved to the leftover buffer before they can get overwritten.
+                Byte buffer[16];
+                bufferUtils::xorBytes(buffer, mLeftoverBuffer.data(), mIv->data(), leftover);
+                bufferUtils::xorBytes(
+                    buffer + leftover, input, mIv->data() + leftover, blockSize - leftover);
+                const Byte* inputEnd = in.data() + std::min(in.size(), (block + 1) * blockSize);
+                mLeftoverBuffer.clear();
+                mLeftoverBuffer.insert(mLeftoverBuffer.end(), input + blockSize - leftover, inputEnd);
+                std::copy(buffer, buffer + blockSize, output);
+            }
+            mCipher.encryptBlock(BufferSlice<Byte>(output, output + blockSize));
+            mIv->setNew(InitializationVector::ConstIterator(output));
+        }
+
+        const Size processedInput = std::min(in.size(), numberOfBlocks * blockSize);
+        mLeftoverBuffer.insert(mLeftoverBuffer.end(), in.data() + processedInput, in.data() + in.size());
+        ASSERT(mLeftoverBuffer.size() < blockSize);
+
+        return numberOfBlocks * blockSize;
+    }
+
     /// Applies padding using the provided scheme
     /// \throws Exception if the provided padding algorithm fails
     template <typename TBuffer>
@@ -90,6 +135,20 @@ public:
         mLeftoverBuffer.clear();
     }
 
+    /// Applies padding using the provided scheme and writes the last block straight into the given output
+    /// \param out The output, must have room for one block
+    /// \returns The number of bytes written to the output
+    /// \throws Exception if the provided padding algorithm fails or in case the output is too small
+    Size finalize(BufferSlice<Byte> out, const Padding& padder) {
+        StaticBuffer<Byte, 16> block;
+        finalize(block, padder);
+        if (out.size() < block.size()) {
+            throw Exception("CBC-Mode: The output buffer is too small");
+        }
+        std::copy(block.begin(), block.end(), out.begin());
+        return block.size();
+    }
+
     /// Resets the CB chain
     void resetChain() { mIv->reset(); }
 
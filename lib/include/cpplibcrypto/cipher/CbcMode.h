@@ -32,11 +32,19 @@ public:
             return mEncryptor.update(input, output);
         }
 
+        Size update(BufferSlice<const Byte> input, BufferSlice<Byte> output) {
+            return mEncryptor.update(input, output);
+        }
+
         template <typename TBuffer>
         void finalize(TBuffer& output, const Padding& padder) {
             mEncryptor.finalize(output, padder);
         }
 
+        Size finalize(BufferSlice<Byte> output, const Padding& padder) {
+            return mEncryptor.finalize(output, padder);
+        }
+
         Size getBlockSize() const { return mCipher.getBlockSize(); }
 
     private:
@@ -57,11 +65,19 @@ public:
             return mDecryptor.update(input, output);
         }
 
+        Size update(BufferSlice<const Byte> input, BufferSlice<Byte> output) {
+            return mDecryptor.update(input, output);
+        }
+
         template <typename TBuffer>
         void finalize(TBuffer& output, const Padding& padder) {
             mDecryptor.finalize(output, padder);
         }
 
+        Size finalize(BufferSlice<Byte> output, const Padding& padder) {
+            return mDecryptor.finalize(output, padder);
+        }
+
         Size getBlockSize() const { return mCipher.getBlockSize(); }
 
     private:
@@ -0,0 +1,151 @@
+#ifndef CPPLIBCRYPTO_CIPHER_CTRCRYPT_H_
+#define CPPLIBCRYPTO_CIPHER_CTRCRYPT_H_
+
+#include "cpplibcrypto/buffer/BufferSlice.h"
+#include "cpplibcrypto/buffer/StaticBuffer.h"
+#include "cpplibcrypto/buffer/utils/bufferUtils.h"
+#include "cpplibcrypto/cipher/BlockCipher.h"
+#include "cpplibcrypto/common/Exception.h"
+#include "cpplibcrypto/common/InitializationVector.h"
+#include "cpplibcrypto/common/common.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace crypto {
+
+/// Block cipher CTR encryptor/decryptor
+///
+/// The keystream is the encryption of consecutive counter blocks, starting at the IV and incremented as a
+/// big-endian number over the whole block (NIST SP 800-38A, appendix B.1). Encryption and decryption are the
+/// same operation, there is no padding and the output always has the size of the input.
+class CtrCrypt {
+public:
+    /// Constructs the encryptor/decryptor using the provided cipher algorithm and IV
+    /// \param cipher Block cipher instance
+    /// \param iv The initial counter block. The size has to match the cipher block size
+    /// \throws Exception in case the IV size does not match the cipher block size
+    CtrCrypt(const BlockCipher& cipher, const InitializationVector& iv)
+        : mCipher(cipher)
+        , mIv(iv.clone()) {
+        if (mIv->size() != mCipher.getBlockSize() || mIv->size() > MAX_BLOCK_SIZE) {
+            throw Exception("CTR-Mode: The Initialization Vector size does not match the cipher block size");
+        }
+        seek(0);
+    }
+
+    /// Encrypts or decrypts the given input
+    /// \param in The data to be processed
+    /// \param out A buffer to which the processed data will be pushed. The buffer is expected to have
+    /// insert() and size() methods.
+    /// \returns The number of bytes pushed to the output, which is always the size of the input
+    template <typename TBuffer>
+    Size update(BufferSlice<const Byte> in, TBuffer& out) {
+        const Size blockSize = mCipher.getBlockSize();
+        const Byte* input = in.data();
+        Size remaining = in.size();
+
+        // Use up the keystream left over from the previous round first
+        if (remaining > 0 && mKeystreamOffset < blockSize) {
+            const Size toProcess = std::min(remaining, blockSize - mKeystreamOffset);
+            Byte buffer[MAX_BLOCK_SIZE];
+            // Less than a block, byte by byte. GCC can't bound the size and warns about the Qword stores of
+            // xorBytes() overflowing the buffer otherwise.
+            for (Size i = 0; i < toProcess; ++i) {
+                buffer[i] = input[i] ^ mKeystream[mKeystreamOffset + i];
+            }
+            out.insert(out.end(), buffer, buffer + toProcess);
+            mKeystreamOffset += toProcess;
+            input += toProcess;
+            remaining -= toProcess;
+        }
+
+        // Whole blocks, the keystream of a run is generated by a single call to the cipher
+        Byte keystream[MAX_RUN_BLOCKS * MAX_BLOCK_SIZE];
+        while (remaining >= blockSize) {
+            const Size runBlocks = std::min(remaining / blockSize, MAX_RUN_BLOCKS);
+            const Size runSize = runBlocks * blockSize;
+            generateKeystream(keystream, runBlocks);
+            bufferUtils::xorBytes(keystream, keystream, input, runSize);
+            out.insert(out.end(), keystream, keystream + runSize);
+            input += runSize;
+            remaining -= runSize;
+        }
+
+        // The rest of the last keystream block is kept for the next round
+        if (remaining > 0) {
+            generateKeystream(mKeystream.data(), 1);
+            bufferUtils::xorBytes(keystream, input, mKeystream.data(), remaining);
+            out.insert(out.end(), keystream, keystream + remaining);
+            mKeystreamOffset = remaining;
+        }
+
+        return in.size();
+    }
+
+    /// Moves to the given position of the keystream
+    ///
+    /// The next \ref update() will process data as if it was located at the given byte offset of the
+    /// stream, without the need to process the preceding data.
+    /// \param byteOffset Offset from the beginning of the stream (the initial counter block)
+    void seek(const Qword byteOffset) {
+        const Size blockSize = mCipher.getBlockSize();
+        mCounter.clear();
+        mCounter.insert(mCounter.end(), mIv->cbegin(), mIv->cend());
+        addToCounter(byteOffset / blockSize);
+
+        mKeystream.resize(blockSize);
+        mKeystreamOffset = byteOffset % blockSize;
+        if (mKeystreamOffset != 0) {
+            generateKeystream(mKeystream.data(), 1);
+        } else {
+            mKeystreamOffset = blockSize;
+        }
+    }
+
+    /// Resets the counter to the initial IV
+    void resetChain() { seek(0); }
+
+private:
+    static constexpr Size MAX_BLOCK_SIZE = 16;
+
+    /// The maximum number of keystream blocks generated by one call to the cipher
+    static constexpr Size MAX_RUN_BLOCKS = 8;
+
+    /// Encrypts the given number of consecutive counter blocks, advancing the counter
+    void generateKeystream(Byte* out, const Size blocks) {
+        const Size blockSize = mCipher.getBlockSize();
+        for (Size i = 0; i < blocks; ++i) {
+            std::copy(mCounter.begin(), mCounter.end(), out + i * blockSize);
+            addToCounter(1);
+        }
+        mCipher.encryptBlocks(out, out, blocks);
+    }
+
+    /// Adds the value to the counter, treating the whole counter block as a big-endian number
+    void addToCounter(Qword value) {
+        for (Size i = mCounter.size(); i > 0 && value != 0; --i) {
+            value += mCounter[i - 1];
+            mCounter[i - 1] = static_cast<Byte>(value);
+            value >>= 8;
+        }
+    }
+
+    // Forbid temporary BlockCipher
+    template <typename... TArgs>
+    CtrCrypt(const BlockCipher&& cipher, TArgs&&...) = delete;
+
+    const BlockCipher& mCipher;
+    std::unique_ptr<InitializationVector> mIv;
+    StaticBuffer<Byte, MAX_BLOCK_SIZE> mCounter;
+
+    /// The keystream block of a partially processed block
+    StaticBuffer<Byte, MAX_BLOCK_SIZE> mKeystream;
+
+    /// Number of bytes of \ref mKeystream already used, the block size if there is none left
+    Size mKeystreamOffset;
+};
+
+} // namespace crypto
+
+#endif // CPPLIBCRYPTO_CIPHER_CTRCRYPT_H_
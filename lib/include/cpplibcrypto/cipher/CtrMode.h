@@ -0,0 +1,67 @@
+#ifndef CPPLIBCRYPTO_CIPHER_CTRMODE_H_
+#define CPPLIBCRYPTO_CIPHER_CTRMODE_H_
+
+#include "cpplibcrypto/buffer/BufferSlice.h"
+#include "cpplibcrypto/cipher/CtrCrypt.h"
+#include "cpplibcrypto/common/Key.h"
+
+namespace crypto {
+
+/// Convenience class for constructing CTR encryptors/decryptors
+///
+/// For more details, see \ref CtrCrypt
+template <typename CipherT>
+class CtrMode final {
+public:
+    using CipherType = CipherT;
+
+    CtrMode() = default;
+
+    struct Encryption {
+        using CipherType = CipherT;
+
+        template <typename TKey>
+        Encryption(const TKey& key, const InitializationVector& iv)
+            : mCipher(key)
+            , mEncryptor(mCipher, iv) {}
+
+        template <typename TBuffer>
+        Size update(BufferSlice<const Byte> input, TBuffer& output) {
+            return mEncryptor.update(input, output);
+        }
+
+        void seek(const Qword byteOffset) { mEncryptor.seek(byteOffset); }
+
+        Size getBlockSize() const { return mCipher.getBlockSize(); }
+
+    private:
+        CipherT mCipher;
+        CtrCrypt mEncryptor;
+    };
+
+    struct Decryption {
+        using CipherType = CipherT;
+
+        template <typename TKey>
+        Decryption(const TKey& key, const InitializationVector& iv)
+            : mCipher(key)
+            , mDecryptor(mCipher, iv) {}
+
+        template <typename TBuffer>
+        Size update(BufferSlice<const Byte> input, TBuffer& output) {
+            return mDecryptor.update(input, output);
+        }
+
+        void seek(const Qword byteOffset) { mDecryptor.seek(byteOffset); }
+
+        Size getBlockSize() const { return mCipher.getBlockSize(); }
+
+    private:
+        CipherT mCipher;
+        CtrCrypt mDecryptor;
+    };
+};
+
+} // namespace crypto
+
+#endif // CPPLIBCRYPTO_CIPHER_CTRMODE_H_
@@ -0,0 +1,96 @@
+#ifndef CPPLIBCRYPTO_CIPHER_ECBMODE_H_
+#define CPPLIBCRYPTO_CIPHER_ECBMODE_H_
+
+#include "cpplibcrypto/buffer/BufferSlice.h"
+#include "cpplibcrypto/common/Exception.h"
+#include "cpplibcrypto/common/Key.h"
+
+namespace crypto {
+
+/// Convenience class for encrypting/decrypting independent blocks
+///
+/// Every block is processed on its own with the same key, there is no chaining, IV or padding. Only meant as
+/// a building block for other modes and for fixed size data of exactly one block, like tokens or
+/// identifiers. Equal plaintext blocks give equal ciphertext blocks, so ECB must not be used for messages.
+///
+/// The blocks are passed to the cipher's multi-block path in one call. The cipher is held by value, so the
+/// calls are resolved statically and don't go through the \ref BlockCipher vtable.
+template <typename CipherT>
+class EcbMode final {
+public:
+    using CipherType = CipherT;
+
+    EcbMode() = default;
+
+    struct Encryption {
+        using CipherType = CipherT;
+
+        template <typename TKey>
+        explicit Encryption(const TKey& key)
+            : mCipher(key) {}
+
+        /// Encrypts the given blocks in place
+        /// \throws Exception if the size of the data is not a multiple of the block size
+        void update(BufferSlice<Byte> data) {
+            mCipher.encryptBlocks(data.data(), data.data(), getBlockCount(data.size()));
+        }
+
+        /// Encrypts the given number of consecutive blocks
+        /// \param in The plaintext, nBlocks * getBlockSize() bytes
+        /// \param out Output for the ciphertext of the same size. May be the same as \p in
+        /// \param nBlocks The number of blocks
+        void update(const Byte* in, Byte* out, const Size nBlocks) {
+            mCipher.encryptBlocks(in, out, nBlocks);
+        }
+
+        Size getBlockSize() const { return mCipher.getBlockSize(); }
+
+    private:
+        Size getBlockCount(const Size size) const {
+            if (size % mCipher.getBlockSize() != 0) {
+                throw Exception("ECB-Mode: Buffer size must be a multiple of block size");
+            }
+            return size / mCipher.getBlockSize();
+        }
+
+        CipherT mCipher;
+    };
+
+    struct Decryption {
+        using CipherType = CipherT;
+
+        template <typename TKey>
+        explicit Decryption(const TKey& key)
+            : mCipher(key) {}
+
+        /// Decrypts the given blocks in place
+        /// \throws Exception if the size of the data is not a multiple of the block size
+        void update(BufferSlice<Byte> data) {
+            mCipher.decryptBlocks(data.data(), data.data(), getBlockCount(data.size()));
+        }
+
+        /// Decrypts the given number of consecutive blocks
+        /// \param in The ciphertext, nBlocks * getBlockSize() bytes
+        /// \param out Output for the plaintext of the same size. May be the same as \p in
+        /// \param nBlocks The number of blocks
+        void update(const Byte* in, Byte* out, const Size nBlocks) {
+            mCipher.decryptBlocks(in, out, nBlocks);
+        }
+
+        Size getBlockSize() const { return mCipher.getBlockSize(); }
+
+    private:
+        Size getBlockCount(const Size size) const {
+            if (size % mCipher.getBlockSize() != 0) {
+                throw Exception("ECB-Mode: Buffer size must be a multiple of block size");
+            }
+            return size / mCipher.getBlockSize();
+        }
+
+        CipherT mCipher;
+    };
+};
+
+} // namespace crypto
+
+#endif // CPPLIBCRYPTO_CIPHER_ECBMODE_H_
@@ -0,0 +1,242 @@
+#ifndef CPPLIBCRYPTO_CIPHER_GCMCORE_H_
+#define CPPLIBCRYPTO_CIPHER_GCMCORE_H_
+
+#include "cpplibcrypto/buffer/BufferSlice.h"
+#include "cpplibcrypto/buffer/StaticBuffer.h"
+#include "cpplibcrypto/buffer/utils/bufferUtils.h"
+#include "cpplibcrypto/cipher/BlockCipher.h"
+#include "cpplibcrypto/cipher/Ghash.h"
+#include "cpplibcrypto/common/Exception.h"
+#include "cpplibcrypto/common/InitializationVector.h"
+#include "cpplibcrypto/common/bitManip.h"
+#include "cpplibcrypto/common/common.h"
+
+#include <algorithm>
+
+namespace crypto {
+
+/// The part of the Galois/Counter Mode (NIST SP 800-38D) common to \ref GcmEncrypt and \ref GcmDecrypt
+///
+/// The message is encrypted in counter mode and the ciphertext is authenticated by GHASH. Both are done in
+/// runs of several blocks, so the GHASH of a run is computed while its ciphertext is still in the cache.
+class GcmCore {
+public:
+    static constexpr Size BLOCK_SIZE = 16;
+    static constexpr Size TAG_SIZE = 16;
+
+    /// The longest message for one IV, 2^32 - 2 blocks. Beyond that the 32-bit counter would wrap around
+    /// and the keystream would repeat.
+    static constexpr Qword MAX_MESSAGE_SIZE = (Qword(1) << 36) - 32;
+
+    virtual ~GcmCore() = default;
+
+    /// Adds additional authenticated data which will not be encrypted
+    ///
+    /// May be called several times, but all the additional data has to be passed before the message.
+    /// \param aad The additional data
+    /// \throws Exception if a part of the message has already been processed or the tag has been computed
+    void updateAad(BufferSlice<const Byte> aad) {
+        checkNotFinalized();
+        if (mAadFinished) {
+            throw Exception("GCM-Mode: Additional data must precede the message");
+        }
+        mAadSize += aad.size();
+
+        const Byte* data = aad.data();
+        Size remaining = aad.size();
+        if (mAadBufferSize > 0) {
+            const Size toCopy = std::min(remaining, BLOCK_SIZE - mAadBufferSize);
+            std::copy(data, data + toCopy, mAadBuffer + mAadBufferSize);
+            mAadBufferSize += toCopy;
+            data += toCopy;
+            remaining -= toCopy;
+            if (mAadBufferSize < BLOCK_SIZE) {
+                return;
+            }
+            mGhash.update(mAadBuffer, 1);
+            mAadBufferSize = 0;
+        }
+        mGhash.update(data, remaining / BLOCK_SIZE);
+        mAadBufferSize = remaining % BLOCK_SIZE;
+        std::copy(data + remaining - mAadBufferSize, data + remaining, mAadBuffer);
+    }
+
+protected:
+    /// \param cipher Block cipher instance with 16 byte blocks
+    /// \param iv The initialization vector. 12 bytes are recommended, other sizes are hashed by GHASH
+    /// \throws Exception if the cipher block size is not 16 bytes or the IV is empty
+    GcmCore(const BlockCipher& cipher, const InitializationVector& iv)
+        : mCipher(cipher)
+        , mGhash(computeHashKey(cipher).data()) {
+        if (iv.size() == 0) {
+            throw Exception("GCM-Mode: The Initialization Vector must not be empty");
+        }
+
+        if (iv.size() == 12) {
+            std::copy(iv.cbegin(), iv.cend(), mCounter);
+            bits::storeBigEndian<Dword>(mCounter + 12, 1);
+        } else {
+            Byte lengths[BLOCK_SIZE] = {};
+            bits::storeBigEndian<Qword>(lengths + 8, Qword(iv.size()) * 8);
+            mGhash.updatePadded(iv.data(), iv.size());
+            mGhash.update(lengths, 1);
+            std::copy(mGhash.getState(), mGhash.getState() + BLOCK_SIZE, mCounter);
+            mGhash.reset();
+        }
+
+        // The first counter block masks the tag, the message starts with the next one
+        generateKeystream(mTagMask, 1);
+    }
+
+    /// Encrypts or decrypts the input and authenticates the ciphertext
+    ///
+    /// \param in The data to be processed
+    /// \param out A buffer to which the processed data will be pushed
+    /// \param encrypting True if \p in is the plaintext, false if it is the ciphertext
+    /// \returns The number of bytes pushed to the output, which is always the size of the input
+    /// \throws Exception if the tag has been computed or the message gets longer than \ref MAX_MESSAGE_SIZE
+    template <typename TBuffer>
+    Size process(BufferSlice<const Byte> in, TBuffer& out, const bool encrypting) {
+        checkNotFinalized();
+        if (in.size() > MAX_MESSAGE_SIZE - mMessageSize) {
+            throw Exception("GCM-Mode: Message is too long");
+        }
+        finishAad();
+        const Byte* input = in.data();
+        Size remaining = in.size();
+        mMessageSize += remaining;
+
+        Byte buffer[MAX_RUN_BLOCKS * BLOCK_SIZE];
+
+        // Finish the partial block of the previous round first
+        if (remaining > 0 && mKeystreamOffset < BLOCK_SIZE) {
+            const Size toProcess = std::min(remaining, BLOCK_SIZE - mKeystreamOffset);
+            bufferUtils::xorBytes(buffer, input, mKeystream + mKeystreamOffset, toProcess);
+            const Byte* ciphertext = encrypting ? buffer : input;
+            std::copy(ciphertext, ciphertext + toProcess, mPartialBlock + mKeystreamOffset);
+            out.insert(out.end(), buffer, buffer + toProcess);
+            mKeystreamOffset += toProcess;
+            input += toProcess;
+            remaining -= toProcess;
+            if (mKeystreamOffset == BLOCK_SIZE) {
+                mGhash.update(mPartialBlock, 1);
+            }
+        }
+
+        while (remaining >= BLOCK_SIZE) {
+            const Size runBlocks = std::min(remaining / BLOCK_SIZE, MAX_RUN_BLOCKS);
+            const Size runSize = runBlocks * BLOCK_SIZE;
+            generateKeystream(buffer, runBlocks);
+            bufferUtils::xorBytes(buffer, buffer, input, runSize);
+            mGhash.update(encrypting ? buffer : input, runBlocks);
+            out.insert(out.end(), buffer, buffer + runSize);
+            input += runSize;
+            remaining -= runSize;
+        }
+
+        // The rest of the last block is kept for the next round
+        if (remaining > 0) {
+            generateKeystream(mKeystream, 1);
+            bufferUtils::xorBytes(buffer, input, mKeystream, remaining);
+            const Byte* ciphertext = encrypting ? buffer : input;
+            std::copy(ciphertext, ciphertext + remaining, mPartialBlock);
+            out.insert(out.end(), buffer, buffer + remaining);
+            mKeystreamOffset = remaining;
+        }
+
+        return in.size();
+    }
+
+    /// Computes the authentication tag of the additional data and the message processed so far
+    /// \param tag Output for the tag, \ref TAG_SIZE bytes
+    /// \throws Exception if the tag has already been computed
+    void computeTag(Byte* tag) {
+        checkNotFinalized();
+        mFinalized = true;
+        finishAad();
+        if (mKeystreamOffset < BLOCK_SIZE) {
+            mGhash.updatePadded(mPartialBlock, mKeystreamOffset);
+            mKeystreamOffset = BLOCK_SIZE;
+        }
+
+        Byte lengths[BLOCK_SIZE];
+        bits::storeBigEndian<Qword>(lengths, mAadSize * 8);
+        bits::storeBigEndian<Qword>(lengths + 8, mMessageSize * 8);
+        mGhash.update(lengths, 1);
+        bufferUtils::xorBytes(tag, mGhash.getState(), mTagMask, TAG_SIZE);
+    }
+
+private:
+    /// The maximum number of blocks processed by one call to the cipher
+    static constexpr Size MAX_RUN_BLOCKS = 8;
+
+    /// Computes the hash key H, the encryption of the zero block
+    /// \throws Exception if the cipher block size is not 16 bytes
+    static StaticBuffer<Byte, BLOCK_SIZE> computeHashKey(const BlockCipher& cipher) {
+        if (cipher.getBlockSize() != BLOCK_SIZE) {
+            throw Exception("GCM-Mode: The cipher block size must be 16 bytes");
+        }
+        StaticBuffer<Byte, BLOCK_SIZE> h(BLOCK_SIZE, Byte(0));
+        cipher.encryptBlock(h);
+        return h;
+    }
+
+    void checkNotFinalized() const {
+        if (mFinalized) {
+            throw Exception("GCM-Mode: The tag already has been computed. Use a new instance and IV for "
+                            "another message.");
+        }
+    }
+
+    /// Pads the additional data, the message follows in a new block
+    void finishAad() {
+        if (mAadFinished) {
+            return;
+        }
+        mGhash.updatePadded(mAadBuffer, mAadBufferSize);
+        mAadFinished = true;
+    }
+
+    /// Encrypts the given number of consecutive counter blocks, incrementing the low 32 bits of the counter
+    void generateKeystream(Byte* out, const Size blocks) {
+        Dword counter = bits::loadBigEndian<Dword>(mCounter + 12);
+        for (Size i = 0; i < blocks; ++i) {
+            std::copy(mCounter, mCounter + 12, out + i * BLOCK_SIZE);
+            bits::storeBigEndian<Dword>(out + i * BLOCK_SIZE + 12, counter++);
+        }
+        bits::storeBigEndian<Dword>(mCounter + 12, counter);
+        mCipher.encryptBlocks(out, out, blocks);
+    }
+
+    // Forbid temporary BlockCipher
+    template <typename... TArgs>
+    GcmCore(const BlockCipher&& cipher, TArgs&&...) = delete;
+
+    const BlockCipher& mCipher;
+    Ghash mGhash;
+
+    /// The next counter block
+    Byte mCounter[BLOCK_SIZE];
+
+    /// The encrypted initial counter block
+    Byte mTagMask[BLOCK_SIZE];
+
+    /// The keystream of a partially processed block and the number of its bytes already used
+    Byte mKeystream[BLOCK_SIZE];
+    Size mKeystreamOffset = BLOCK_SIZE;
+
+    /// The ciphertext of a partially processed block, waiting to be authenticated
+    Byte mPartialBlock[BLOCK_SIZE];
+
+    Byte mAadBuffer[BLOCK_SIZE];
+    Size mAadBufferSize = 0;
+    bool mAadFinished = false;
+
+    Qword mAadSize = 0;
+    Qword mMessageSize = 0;
+    bool mFinalized = false;
+};
+
+} // namespace crypto
+
+#endif // CPPLIBCRYPTO_CIPHER_GCMCORE_H_
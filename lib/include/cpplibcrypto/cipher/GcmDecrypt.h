@@ -0,0 +1,53 @@
+#ifndef CPPLIBCRYPTO_CIPHER_GCMDECRYPT_H_
+#define CPPLIBCRYPTO_CIPHER_GCMDECRYPT_H_
+
+#include "cpplibcrypto/cipher/GcmCore.h"
+
+namespace crypto {
+
+/// Block cipher GCM decryptor
+///
+/// The plaintext is pushed to the output as it is decrypted, but it must not be trusted until \ref
+/// finalize() succeeds.
+class GcmDecrypt : public GcmCore {
+public:
+    /// Constructs decryptor using the provided cipher algorithm and IV
+    /// \param cipher Block cipher instance with 16 byte blocks
+    /// \param iv The initialization vector used for the encryption
+    /// \throws Exception if the cipher block size is not 16 bytes or the IV is empty
+    GcmDecrypt(const BlockCipher& cipher, const InitializationVector& iv)
+        : GcmCore(cipher, iv) {}
+
+    /// Decrypts the given input
+    /// \param in The data to be decrypted
+    /// \param out A buffer to which the decrypted data will be pushed. The buffer is expected to have
+    /// insert() and size() methods.
+    /// \returns The number of bytes pushed to the output, which is always the size of the input
+    /// \throws Exception if \ref finalize() has already been called or the message gets longer than
+    /// \ref MAX_MESSAGE_SIZE
+    template <typename TBuffer>
+    Size update(BufferSlice<const Byte> in, TBuffer& out) {
+        return process(in, out, false);
+    }
+
+    /// Verifies the authentication tag
+    /// \param tag The tag produced by \ref GcmEncrypt::finalize()
+    /// \throws Exception if the tag does not match or \ref finalize() has already been called
+    void finalize(BufferSlice<const Byte> tag) {
+        Byte expected[TAG_SIZE];
+        computeTag(expected);
+
+        // Compare in constant time, not to reveal how many bytes of the tag are correct
+        Byte difference = tag.size() == TAG_SIZE ? 0 : 1;
+        for (Size i = 0; i < std::min(tag.size(), TAG_SIZE); ++i) {
+            difference |= expected[i] ^ tag[i];
+        }
+        if (difference != 0) {
+            throw Exception("GCM-Mode: Authentication failed");
+        }
+    }
+};
+
+} // namespace crypto
+
+#endif // CPPLIBCRYPTO_CIPHER_GCMDECRYPT_H_
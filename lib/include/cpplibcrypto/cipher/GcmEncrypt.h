@@ -0,0 +1,44 @@
+#ifndef CPPLIBCRYPTO_CIPHER_GCMENCRYPT_H_
+#define CPPLIBCRYPTO_CIPHER_GCMENCRYPT_H_
+
+#include "cpplibcrypto/cipher/GcmCore.h"
+
+namespace crypto {
+
+/// Block cipher GCM encryptor
+///
+/// Encrypts and authenticates the message in one pass. Never use the same key and IV pair twice.
+class GcmEncrypt : public GcmCore {
+public:
+    /// Constructs encryptor using the provided cipher algorithm and IV
+    /// \param cipher Block cipher instance with 16 byte blocks
+    /// \param iv The initialization vector, see \ref GcmIv
+    /// \throws Exception if the cipher block size is not 16 bytes or the IV is empty
+    GcmEncrypt(const BlockCipher& cipher, const InitializationVector& iv)
+        : GcmCore(cipher, iv) {}
+
+    /// Encrypts the given input
+    /// \param in The data to be encrypted
+    /// \param out A buffer to which the encrypted data will be pushed. The buffer is expected to have
+    /// insert() and size() methods.
+    /// \returns The number of bytes pushed to the output, which is always the size of the input
+    /// \throws Exception if \ref finalize() has already been called or the message gets longer than
+    /// \ref MAX_MESSAGE_SIZE
+    template <typename TBuffer>
+    Size update(BufferSlice<const Byte> in, TBuffer& out) {
+        return process(in, out, true);
+    }
+
+    /// Pushes the authentication tag, \ref TAG_SIZE bytes, to the given buffer
+    /// \throws Exception if \ref finalize() has already been called
+    template <typename TBuffer>
+    void finalize(TBuffer& tag) {
+        Byte buffer[TAG_SIZE];
+        computeTag(buffer);
+        tag.insert(tag.end(), buffer, buffer + TAG_SIZE);
+    }
+};
+
+} // namespace crypto
+
+#endif // CPPLIBCRYPTO_CIPHER_GCMENCRYPT_H_
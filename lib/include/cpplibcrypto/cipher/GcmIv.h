@@ -0,0 +1,70 @@
+#ifndef CPPLIBCRYPTO_CIPHER_GCMIV_H_
+#define CPPLIBCRYPTO_CIPHER_GCMIV_H_
+
+#include "cpplibcrypto/common/InitializationVectorSized.h"
+
+#include <memory>
+
+#include "cpplibcrypto/buffer/DynamicBuffer.h"
+#include "cpplibcrypto/buffer/HexString.h"
+#include "cpplibcrypto/common/Exception.h"
+#include "cpplibcrypto/common/common.h"
+
+namespace crypto {
+
+/// Represents the recommended 96-bit initialization vector (nonce) for GCM
+class GcmIv : public InitializationVectorSized<12> {
+public:
+    /// \throws Exception if the IV size is not 12 bytes
+    GcmIv(ByteBuffer&& iv) {
+        if (!isValid(iv.size())) {
+            throw Exception("GCM-IV: Invalid Initialization Vector size passed");
+        }
+        mIv = std::move(iv);
+        mInitialIv << mIv;
+    }
+
+    /// \throws Exception if the IV size is not 12 bytes
+    GcmIv(const HexString& iv) {
+        if (!isValid(iv.size())) {
+            throw Exception("GCM-IV: Invalid Initialization Vector size passed");
+        }
+        mIv << iv;
+        mInitialIv << iv;
+    }
+
+    /// Returns the size of the key in bytes
+    Size size() const override { return mIv.size(); }
+
+    /// Sets the IV to the initial state
+    void reset() override { mIv.replace(mIv.begin(), mIv.end(), mInitialIv.begin()); }
+
+    /// Sets new IV
+    void setNew(const ConstIterator begin) override { mIv.replace(mIv.begin(), mIv.end(), begin); }
+
+    /// Returns a byte at the specified index
+    ConstReference at(const Size index) const override { return mIv.at(index); }
+
+    /// \copydoc at()
+    ConstReference operator[](const Size index) const override { return mIv[index]; }
+
+    /// Returns a pointer to the beginning of the IV byte sequence
+    ConstPointer data() const override { return mIv.data(); }
+
+    /// Creates a copy of this instance
+    virtual std::unique_ptr<InitializationVector> clone() const override {
+        ByteBuffer ivCopy;
+        ivCopy << mIv;
+        return std::make_unique<GcmIv>(std::move(ivCopy));
+    }
+
+private:
+    ByteBuffer mIv;
+
+    /// This will always store the initial IV so we are able to reset the IV in the future
+    ByteBuffer mInitialIv;
+};
+
+} // namespace crypto
+
+#endif // CPPLIBCRYPTO_CIPHER_GCMIV_H_
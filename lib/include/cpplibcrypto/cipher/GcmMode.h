@@ -0,0 +1,75 @@
+#ifndef CPPLIBCRYPTO_CIPHER_GCMMODE_H_
+#define CPPLIBCRYPTO_CIPHER_GCMMODE_H_
+
+#include "cpplibcrypto/buffer/BufferSlice.h"
+#include "cpplibcrypto/cipher/GcmDecrypt.h"
+#include "cpplibcrypto/cipher/GcmEncrypt.h"
+#include "cpplibcrypto/common/Key.h"
+
+namespace crypto {
+
+/// Convenience class for constructing GCM encryptors/decryptors
+///
+/// For more details, see \ref GcmEncrypt and \ref GcmDecrypt
+template <typename CipherT>
+class GcmMode final {
+public:
+    using CipherType = CipherT;
+
+    GcmMode() = default;
+
+    struct Encryption {
+        using CipherType = CipherT;
+
+        template <typename TKey>
+        Encryption(const TKey& key, const InitializationVector& iv)
+            : mCipher(key)
+            , mEncryptor(mCipher, iv) {}
+
+        void updateAad(BufferSlice<const Byte> aad) { mEncryptor.updateAad(aad); }
+
+        template <typename TBuffer>
+        Size update(BufferSlice<const Byte> input, TBuffer& output) {
+            return mEncryptor.update(input, output);
+        }
+
+        template <typename TBuffer>
+        void finalize(TBuffer& tag) {
+            mEncryptor.finalize(tag);
+        }
+
+        Size getBlockSize() const { return mCipher.getBlockSize(); }
+
+    private:
+        CipherT mCipher;
+        GcmEncrypt mEncryptor;
+    };
+
+    struct Decryption {
+        using CipherType = CipherT;
+
+        template <typename TKey>
+        Decryption(const TKey& key, const InitializationVector& iv)
+            : mCipher(key)
+            , mDecryptor(mCipher, iv) {}
+
+        void updateAad(BufferSlice<const Byte> aad) { mDecryptor.updateAad(aad); }
+
+        template <typename TBuffer>
+        Size update(BufferSlice<const Byte> input, TBuffer& output) {
+            return mDecryptor.update(input, output);
+        }
+
+        void finalize(BufferSlice<const Byte> tag) { mDecryptor.finalize(tag); }
+
+        Size getBlockSize() const { return mCipher.getBlockSize(); }
+
+    private:
+        CipherT mCipher;
+        GcmDecrypt mDecryptor;
+    };
+};
+
+} // namespace crypto
+
+#endif // CPPLIBCRYPTO_CIPHER_GCMMODE_H_
@@ -0,0 +1,162 @@
+#ifndef CPPLIBCRYPTO_CIPHER_GHASH_H_
+#define CPPLIBCRYPTO_CIPHER_GHASH_H_
+
+#include "cpplibcrypto/cipher/GhashClmul.h"
+#include "cpplibcrypto/common/Exception.h"
+#include "cpplibcrypto/common/bitManip.h"
+#include "cpplibcrypto/common/common.h"
+
+#include <algorithm>
+
+namespace crypto {
+
+/// The GHASH universal hash function of GCM (NIST SP 800-38D, section 6.4)
+///
+/// Multiplication in GF(2^128) is done either by the PCLMULQDQ instruction or by the portable 4-bit table
+/// method (Shoup's method with 16 precomputed multiples of the hash key). Unless requested otherwise, the
+/// carry-less multiplication is used whenever the CPU supports it.
+class Ghash final {
+public:
+    static constexpr Size BLOCK_SIZE = 16;
+
+    /// Implementation of the GF(2^128) multiplication
+    enum class Implementation {
+        /// Portable implementation using 4-bit lookup tables
+        Table,
+        /// Hardware implementation using the PCLMULQDQ instruction, see \ref GhashClmul
+        Clmul,
+    };
+
+    /// Creates the hash using the fastest supported implementation
+    /// \param h The hash key, 16 bytes
+    explicit Ghash(const Byte* h)
+        : Ghash(h, getDefaultImplementation()) {}
+
+    /// Creates the hash using the given implementation
+    /// \param h The hash key, 16 bytes
+    /// \param implementation The implementation to use
+    /// \throws Exception if the implementation is not supported on this CPU
+    Ghash(const Byte* h, const Implementation implementation)
+        : mImplementation(implementation) {
+        if (!isSupported(implementation)) {
+            throw Exception("GHASH: Implementation not supported on this CPU");
+        }
+        if (mImplementation == Implementation::Clmul) {
+            GhashClmul::expandKey(h, mKeyPowers);
+        } else {
+            expandKey(h);
+        }
+    }
+
+    /// Absorbs whole blocks
+    ///
+    /// \param data The data, 16 * nBlocks bytes
+    /// \param nBlocks The number of blocks
+    void update(const Byte* data, const Size nBlocks) {
+        if (mImplementation == Implementation::Clmul) {
+            GhashClmul::update(mState, mKeyPowers, data, nBlocks);
+            return;
+        }
+        for (Size block = 0; block < nBlocks; ++block) {
+            for (Size i = 0; i < BLOCK_SIZE; ++i) {
+                mState[i] ^= data[BLOCK_SIZE * block + i];
+            }
+            multiplyByKey();
+        }
+    }
+
+    /// Absorbs the data, padding the last incomplete block with zeros
+    ///
+    /// \param data The data
+    /// \param size The size of the data in bytes
+    void updatePadded(const Byte* data, const Size size) {
+        update(data, size / BLOCK_SIZE);
+        const Size remaining = size % BLOCK_SIZE;
+        if (remaining > 0) {
+            Byte block[BLOCK_SIZE] = {};
+            std::copy(data + size - remaining, data + size, block);
+            update(block, 1);
+        }
+    }
+
+    /// Returns the current hash value, 16 bytes
+    const Byte* getState() const { return mState; }
+
+    /// Sets the hash value to zero
+    void reset() { std::fill(mState, mState + BLOCK_SIZE, 0); }
+
+    /// Returns the implementation used by this instance
+    Implementation getImplementation() const { return mImplementation; }
+
+    /// Returns true if the given implementation can be used on this CPU
+    static bool isSupported(const Implementation implementation) {
+        return implementation == Implementation::Table || GhashClmul::isSupported();
+    }
+
+    /// Returns the fastest implementation supported on this CPU
+    static Implementation getDefaultImplementation() {
+        return GhashClmul::isSupported() ? Implementation::Clmul : Implementation::Table;
+    }
+
+private:
+    /// Computes the multiples of the hash key by all the 4-bit polynomials
+    ///
+    /// Bit-reflected, so halving the value multiplies it by x. Entry 8 (x^0) is the key itself, the
+    /// remaining power-of-two entries are obtained by repeated multiplication by x, the rest by additions.
+    void expandKey(const Byte* h) {
+        Qword high = bits::loadBigEndian<Qword>(h);
+        Qword low = bits::loadBigEndian<Qword>(h + 8);
+        mTableHigh[0] = mTableLow[0] = 0;
+        mTableHigh[8] = high;
+        mTableLow[8] = low;
+        for (Size i = 4; i > 0; i >>= 1) {
+            const Qword reduction = (low & 1) ? R : 0;
+            low = (high << 63) | (low >> 1);
+            high = (high >> 1) ^ reduction;
+            mTableHigh[i] = high;
+            mTableLow[i] = low;
+        }
+        for (Size i = 2; i <= 8; i <<= 1) {
+            for (Size j = 1; j < i; ++j) {
+                mTableHigh[i + j] = mTableHigh[i] ^ mTableHigh[j];
+                mTableLow[i + j] = mTableLow[i] ^ mTableLow[j];
+            }
+        }
+    }
+
+    /// Multiplies the state by the hash key, processing it by nibbles from the last one
+    void multiplyByKey() {
+        // Reduction of the nibble shifted out of the low end
+        static constexpr Qword reductionTable[16] = {
+            0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+            0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0,
+        };
+
+        Qword high = 0;
+        Qword low = 0;
+        for (Size i = BLOCK_SIZE; i > 0; --i) {
+            for (const Byte nibble : { Byte(mState[i - 1] & 0x0f), Byte(mState[i - 1] >> 4) }) {
+                const Byte shiftedOut = low & 0x0f;
+                low = (high << 60) | (low >> 4);
+                high = (high >> 4) ^ (reductionTable[shiftedOut] << 48);
+                high ^= mTableHigh[nibble];
+                low ^= mTableLow[nibble];
+            }
+        }
+        bits::storeBigEndian(mState, high);
+        bits::storeBigEndian(mState + 8, low);
+    }
+
+    /// The reduction polynomial x^128 + x^7 + x^2 + x + 1 in the bit-reflected representation
+    static constexpr Qword R = 0xe100000000000000ULL;
+
+    Implementation mImplementation;
+    Byte mState[BLOCK_SIZE] = {};
+    Qword mTableHigh[16];
+    Qword mTableLow[16];
+    Byte mKeyPowers[GhashClmul::KEY_TABLE_SIZE];
+};
+
+} // namespace crypto
+
+#endif // CPPLIBCRYPTO_CIPHER_GHASH_H_
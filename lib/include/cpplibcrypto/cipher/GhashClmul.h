@@ -0,0 +1,40 @@
+#ifndef CPPLIBCRYPTO_CIPHER_GHASHCLMUL_H_
+#define CPPLIBCRYPTO_CIPHER_GHASHCLMUL_H_
+
+#include "cpplibcrypto/common/common.h"
+
+namespace crypto {
+
+/// GHASH implementation using the carry-less multiplication (PCLMULQDQ) instruction
+///
+/// Four blocks are multiplied by the matching powers of the hash key and summed before a single reduction.
+/// None of the methods but \ref isSupported() may be called unless \ref isSupported() returns true.
+class GhashClmul final {
+public:
+    /// The size of the precomputed key powers produced by \ref expandKey()
+    static constexpr Size KEY_TABLE_SIZE = 4 * 16;
+
+    /// Returns true if the library was built with PCLMULQDQ support and the CPU supports it
+    static bool isSupported();
+
+    /// Precomputes H, H^2, H^3 and H^4
+    ///
+    /// \param h The hash key, 16 bytes
+    /// \param table Output for the key powers, \ref KEY_TABLE_SIZE bytes
+    static void expandKey(const Byte* h, Byte* table);
+
+    /// Absorbs whole blocks into the GHASH state
+    ///
+    /// \param state The 16 byte GHASH state, updated in place
+    /// \param table The key powers produced by \ref expandKey()
+    /// \param data The data, 16 * nBlocks bytes
+    /// \param nBlocks The number of blocks
+    static void update(Byte* state, const Byte* table, const Byte* data, Size nBlocks);
+
+private:
+    GhashClmul() = delete;
+};
+
+} // namespace crypto
+
+#endif // CPPLIBCRYPTO_CIPHER_GHASHCLMUL_H_
@@ -0,0 +1,159 @@
+#ifndef CPPLIBCRYPTO_CIPHER_XTSCRYPT_H_
+#define CPPLIBCRYPTO_CIPHER_XTSCRYPT_H_
+
+#include "cpplibcrypto/buffer/utils/bufferUtils.h"
+#include "cpplibcrypto/cipher/BlockCipher.h"
+#include "cpplibcrypto/common/Exception.h"
+#include "cpplibcrypto/common/bitManip.h"
+#include "cpplibcrypto/common/common.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace crypto {
+
+/// Block cipher XTS encryptor/decryptor (IEEE 1619, NIST SP 800-38E)
+///
+/// Every data unit (sector) is encrypted independently. The tweak of a sector is its number encrypted with
+/// the tweak cipher, block j of the sector is XORed with the tweak multiplied by alpha^j in GF(2^128) before
+/// and after going through the data cipher. A sector whose size is not a multiple of the block size is
+/// handled by ciphertext stealing, so the ciphertext always has the size of the plaintext.
+class XtsCrypt {
+public:
+    static constexpr Size BLOCK_SIZE = 16;
+
+    /// The largest sector, 2^20 blocks as limited by SP 800-38E
+    static constexpr Size MAX_SECTOR_SIZE = (Size(1) << 20) * BLOCK_SIZE;
+
+    /// Constructs the encryptor/decryptor using the provided ciphers
+    ///
+    /// The two keys must differ, \ref XtsMode checks that.
+    /// \param dataCipher Block cipher instance keyed with the data key (Key1)
+    /// \param tweakCipher Block cipher instance keyed with the tweak key (Key2)
+    /// \throws Exception in case the cipher block size is not 16 bytes
+    XtsCrypt(const BlockCipher& dataCipher, const BlockCipher& tweakCipher)
+        : mDataCipher(dataCipher)
+        , mTweakCipher(tweakCipher) {
+        if (mDataCipher.getBlockSize() != BLOCK_SIZE || mTweakCipher.getBlockSize() != BLOCK_SIZE) {
+            throw Exception("XTS-Mode: The cipher block size must be 16 bytes");
+        }
+    }
+
+    /// Encrypts one sector
+    /// \param sector The sector number, used as the tweak
+    /// \param in The plaintext of the sector
+    /// \param out Output for the ciphertext of the same size. May be the same as \p in, but must not overlap
+    /// it otherwise
+    /// \param size The size of the sector in bytes
+    /// \throws Exception in case the sector is shorter than one block or longer than \ref MAX_SECTOR_SIZE
+    void encryptSector(const Qword sector, const Byte* in, Byte* out, const Size size) const {
+        process(true, sector, in, out, size);
+    }
+
+    /// Decrypts one sector
+    /// \param sector The sector number, used as the tweak
+    /// \param in The ciphertext of the sector
+    /// \param out Output for the plaintext of the same size. May be the same as \p in, but must not overlap
+    /// it otherwise
+    /// \param size The size of the sector in bytes
+    /// \throws Exception in case the sector is shorter than one block or longer than \ref MAX_SECTOR_SIZE
+    void decryptSector(const Qword sector, const Byte* in, Byte* out, const Size size) const {
+        process(false, sector, in, out, size);
+    }
+
+private:
+    /// The number of blocks whose tweaks are computed and which are passed to the cipher at once
+    static constexpr Size MAX_RUN_BLOCKS = 8;
+
+    void process(const bool encrypt, const Qword sector, const Byte* in, Byte* out, const Size size) const {
+        if (size < BLOCK_SIZE) {
+            throw Exception("XTS-Mode: The sector must be at least one block long");
+        }
+        if (size > MAX_SECTOR_SIZE) {
+            throw Exception("XTS-Mode: The sector must not be longer than 2^20 blocks");
+        }
+
+        Byte tweak[BLOCK_SIZE] = {};
+        bits::storeLittleEndian(tweak, sector);
+        mTweakCipher.encryptBlocks(tweak, tweak, 1);
+
+        // With a partial last block, the last whole block takes part in the ciphertext stealing
+        const Size remainder = size % BLOCK_SIZE;
+        const Size runBlocks = size / BLOCK_SIZE - (remainder != 0 ? 1 : 0);
+
+        Byte tweaks[MAX_RUN_BLOCKS * BLOCK_SIZE];
+        Byte buffer[MAX_RUN_BLOCKS * BLOCK_SIZE];
+        for (Size done = 0; done < runBlocks;) {
+            const Size blocks = std::min(runBlocks - done, MAX_RUN_BLOCKS);
+            const Size runSize = blocks * BLOCK_SIZE;
+            for (Size i = 0; i < blocks; ++i) {
+                std::memcpy(tweaks + i * BLOCK_SIZE, tweak, BLOCK_SIZE);
+                multiplyByAlpha(tweak);
+            }
+            bufferUtils::xorBytes(buffer, in + done * BLOCK_SIZE, tweaks, runSize);
+            crypt(encrypt, buffer, blocks);
+            bufferUtils::xorBytes(out + done * BLOCK_SIZE, buffer, tweaks, runSize);
+            done += blocks;
+        }
+        if (remainder == 0) {
+            return;
+        }
+
+        // Ciphertext stealing, the two last blocks are processed in the opposite tweak order for decryption
+        Byte nextTweak[BLOCK_SIZE];
+        std::memcpy(nextTweak, tweak, BLOCK_SIZE);
+        multiplyByAlpha(nextTweak);
+        const Byte* lastIn = in + runBlocks * BLOCK_SIZE;
+        Byte* lastOut = out + runBlocks * BLOCK_SIZE;
+
+        Byte block[BLOCK_SIZE];
+        processBlock(encrypt, lastIn, encrypt ? tweak : nextTweak, block);
+        Byte stolen[BLOCK_SIZE];
+        std::memcpy(stolen, lastIn + BLOCK_SIZE, remainder);
+        std::memcpy(stolen + remainder, block + remainder, BLOCK_SIZE - remainder);
+        std::memcpy(lastOut + BLOCK_SIZE, block, remainder);
+        processBlock(encrypt, stolen, encrypt ? nextTweak : tweak, lastOut);
+    }
+
+    /// Processes one block with the given tweak
+    void processBlock(const bool encrypt, const Byte* in, const Byte* tweak, Byte* out) const {
+        Byte buffer[BLOCK_SIZE];
+        bufferUtils::xorBytes(buffer, in, tweak, BLOCK_SIZE);
+        crypt(encrypt, buffer, 1);
+        bufferUtils::xorBytes(out, buffer, tweak, BLOCK_SIZE);
+    }
+
+    void crypt(const bool encrypt, Byte* data, const Size blocks) const {
+        if (encrypt) {
+            mDataCipher.encryptBlocks(data, data, blocks);
+        } else {
+            mDataCipher.decryptBlocks(data, data, blocks);
+        }
+    }
+
+    /// Multiplies the tweak by the primitive element alpha (x) of GF(2^128), modulo x^128 + x^7 + x^2 + x + 1
+    ///
+    /// The tweak is a little-endian 128-bit number, so this is a left shift with the carry out of the top bit
+    /// reduced into the lowest byte.
+    static void multiplyByAlpha(Byte* tweak) {
+        const Qword low = bits::loadLittleEndian<Qword>(tweak);
+        const Qword high = bits::loadLittleEndian<Qword>(tweak + 8);
+        const Qword carry = high >> 63;
+        bits::storeLittleEndian(tweak, (low << 1) ^ (carry * 0x87));
+        bits::storeLittleEndian(tweak + 8, (high << 1) | (low >> 63));
+    }
+
+    // Forbid temporary BlockCipher
+    template <typename... TArgs>
+    XtsCrypt(const BlockCipher&& dataCipher, TArgs&&...) = delete;
+
+    XtsCrypt(const XtsCrypt&) = delete;
+    XtsCrypt& operator=(const XtsCrypt&) = delete;
+
+    const BlockCipher& mDataCipher;
+    const BlockCipher& mTweakCipher;
+};
+
+} // namespace crypto
+
+#endif // CPPLIBCRYPTO_CIPHER_XTSCRYPT_H_
@@ -0,0 +1,102 @@
+#ifndef CPPLIBCRYPTO_CIPHER_XTSMODE_H_
+#define CPPLIBCRYPTO_CIPHER_XTSMODE_H_
+
+#include "cpplibcrypto/buffer/BufferSlice.h"
+#include "cpplibcrypto/buffer/DynamicBuffer.h"
+#include "cpplibcrypto/cipher/XtsCrypt.h"
+#include "cpplibcrypto/common/Exception.h"
+#include "cpplibcrypto/common/Key.h"
+
+#include <algorithm>
+
+namespace crypto {
+
+/// Convenience class for constructing XTS sector encryptors/decryptors
+///
+/// XTS uses two keys of the same size, the data key (Key1) and the tweak key (Key2). For XTS-AES-256 these
+/// are the two halves of the 512-bit key. The keys must differ (IEEE 1619, SP 800-38E), the constructors
+/// throw an Exception if they are the same. For more details, see \ref XtsCrypt
+template <typename CipherT>
+class XtsMode final {
+public:
+    using CipherType = CipherT;
+
+    XtsMode() = default;
+
+    struct Encryption {
+        using CipherType = CipherT;
+
+        /// \throws Exception if the keys are the same
+        template <typename TKey>
+        Encryption(const TKey& dataKey, const TKey& tweakKey)
+            : mDataCipher(checkDistinctKeys(dataKey, tweakKey))
+            , mTweakCipher(tweakKey)
+            , mEncryptor(mDataCipher, mTweakCipher) {}
+
+        /// Encrypts the given sector in place
+        void update(const Qword sector, BufferSlice<Byte> data) {
+            mEncryptor.encryptSector(sector, data.data(), data.data(), data.size());
+        }
+
+        /// Encrypts the given sector, see \ref XtsCrypt::encryptSector()
+        void update(const Qword sector, const Byte* in, Byte* out, const Size size) {
+            mEncryptor.encryptSector(sector, in, out, size);
+        }
+
+        Size getBlockSize() const { return mDataCipher.getBlockSize(); }
+
+    private:
+        CipherT mDataCipher;
+        CipherT mTweakCipher;
+        XtsCrypt mEncryptor;
+    };
+
+    struct Decryption {
+        using CipherType = CipherT;
+
+        /// \throws Exception if the keys are the same
+        template <typename TKey>
+        Decryption(const TKey& dataKey, const TKey& tweakKey)
+            : mDataCipher(checkDistinctKeys(dataKey, tweakKey))
+            , mTweakCipher(tweakKey)
+            , mDecryptor(mDataCipher, mTweakCipher) {}
+
+        /// Decrypts the given sector in place
+        void update(const Qword sector, BufferSlice<Byte> data) {
+            mDecryptor.decryptSector(sector, data.data(), data.data(), data.size());
+        }
+
+        /// Decrypts the given sector, see \ref XtsCrypt::decryptSector()
+        void update(const Qword sector, const Byte* in, Byte* out, const Size size) {
+            mDecryptor.decryptSector(sector, in, out, size);
+        }
+
+        Size getBlockSize() const { return mDataCipher.getBlockSize(); }
+
+    private:
+        CipherT mDataCipher;
+        CipherT mTweakCipher;
+        XtsCrypt mDecryptor;
+    };
+
+private:
+    /// Returns \p dataKey after checking that it differs from \p tweakKey
+    template <typename TKey>
+    static const TKey& checkDistinctKeys(const TKey& dataKey, const TKey& tweakKey) {
+        const ByteBuffer& data = dataKey.getBytes();
+        const ByteBuffer& tweak = tweakKey.getBytes();
+        // Compare in constant time, not to reveal how much of the keys is the same
+        Byte difference = data.size() == tweak.size() ? 0 : 1;
+        for (Size i = 0; i < std::min(data.size(), tweak.size()); ++i) {
+            difference |= data[i] ^ tweak[i];
+        }
+        if (difference == 0) {
+            throw Exception("XTS-Mode: The data key and the tweak key must differ");
+        }
+        return dataKey;
+    }
+};
+
+} // namespace crypto
+
+#endif // CPPLIBCRYPTO_CIPHER_XTSMODE_H_
@@ -0,0 +1,36 @@
+#ifndef CPPLIBCRYPTO_COMMON_CPU_H_
+#define CPPLIBCRYPTO_COMMON_CPU_H_
+
+namespace crypto {
+
+/// Runtime detection of optional CPU instruction set extensions
+///
+/// The features are queried only once, on the first call. All the methods return false on architectures
+/// where the extension does not exist.
+class Cpu final {
+public:
+    /// Returns true if the CPU supports the AES-NI instructions (AESENC, AESDEC, AESIMC, ...)
+    static bool hasAesNi();
+
+    /// Returns true if the CPU supports the SSSE3 instructions
+    static bool hasSsse3();
+
+    /// Returns true if the CPU supports the carry-less multiplication (PCLMULQDQ) and SSSE3 instructions
+    static bool hasPclmul();
+
+    /// Returns true if the CPU supports the Intel SHA extensions and SSE4.1
+    static bool hasSha();
+
+    /// Returns true if the CPU supports AVX2 and the operating system saves the YMM registers
+    static bool hasAvx2();
+
+    /// Returns true if the CPU supports AVX-512 Foundation and the operating system saves the ZMM registers
+    static bool hasAvx512();
+
+private:
+    Cpu() = delete;
+};
+
+} // namespace crypto
+
+#endif // CPPLIBCRYPTO_COMMON_CPU_H_
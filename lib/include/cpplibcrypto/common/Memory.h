@@ -72,6 +72,17 @@ constexpr void wipe(T* ptr) {
     }
 }
 
+/// Wipes the given number of bytes at the given pointer
+///
+/// The bytes are written through a volatile pointer, so the compiler can't drop the writes even if the
+/// memory is not read any more, as with local arrays right before returning.
+inline void wipe(void* ptr, const Size size) {
+    volatile Byte* bytePtr = static_cast<Byte*>(ptr);
+    for (Size i = 0; i < size; ++i) {
+        bytePtr[i] = 0;
+    }
+}
+
 } // namespace crypto::memory
 
 #endif
@@ -0,0 +1,85 @@
+#ifndef CPPLIBCRYPTO_COMMON_PARALLEL_H_
+#define CPPLIBCRYPTO_COMMON_PARALLEL_H_
+
+#include "cpplibcrypto/common/common.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace crypto::parallel {
+
+/// Returns the number of threads to use for the given setting
+///
+/// The setting counts the calling thread, so 1 runs everything on the calling thread. 0 uses
+/// std::thread::hardware_concurrency().
+inline Size resolveThreadCount(const Size threadCount) {
+    if (threadCount == 0) {
+        return std::max(1U, std::thread::hardware_concurrency());
+    }
+    return threadCount;
+}
+
+/// Runs `process(index, state)` for every index from 0 to \p count - 1
+///
+/// The work is spread over up to \p threadCount threads (see \ref resolveThreadCount()), the calling
+/// thread being one of them. The threads pick the indices from a shared counter, so the order is not
+/// defined. Every thread constructs its own TState, for buffers and hashers reused between the indices.
+///
+/// If a thread can't be started, its share is taken over by the others. If \p process or the TState
+/// constructor throws, the remaining indices are skipped and the first exception is rethrown on the
+/// calling thread once all the threads have finished.
+template <typename TState, typename TProcess>
+void forEachWithState(const Size count, const Size threadCount, TProcess process) {
+    std::atomic<Size> next(0);
+    std::mutex errorMutex;
+    std::exception_ptr error;
+    auto worker = [&]() {
+        try {
+            TState state;
+            for (Size index = next++; index < count; index = next++) {
+                process(index, state);
+            }
+        } catch (...) {
+            const std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            next = count;
+        }
+    };
+
+    const Size threads = std::min(count, resolveThreadCount(threadCount));
+    std::vector<std::thread> started;
+    try {
+        started.reserve(threads > 0 ? threads - 1 : 0);
+        for (Size i = 1; i < threads; ++i) {
+            started.emplace_back(worker);
+        }
+    } catch (...) {
+        // Not fatal, the threads which did start keep picking up the indices
+    }
+    worker();
+    for (auto& thread : started) {
+        thread.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+/// Runs `process(index)` for every index from 0 to \p count - 1, see \ref forEachWithState()
+template <typename TProcess>
+void forEach(const Size count, const Size threadCount, TProcess process) {
+    struct NoState {};
+    forEachWithState<NoState>(count, threadCount, [&process](const Size index, NoState&) {
+        process(index);
+    });
+}
+
+} // namespace crypto::parallel
+
+#endif // CPPLIBCRYPTO_COMMON_PARALLEL_H_
@@ -0,0 +1,66 @@
+#ifndef CPPLIBCRYPTO_COMMON_SPSCQUEUE_H_
+#define CPPLIBCRYPTO_COMMON_SPSCQUEUE_H_
+
+#include "cpplibcrypto/common/common.h"
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace crypto {
+
+/// Bounded lock-free queue for exactly one producer and one consumer thread
+///
+/// A ring of slots with the head owned by the consumer and the tail by the producer. Each side only reads the
+/// other one's index, so pushing and popping never blocks and needs no lock. The indices live on separate
+/// cache lines, so the two threads don't keep invalidating each other's line. The queue never waits, waiting
+/// for an item or for space is up to the caller.
+template <typename T>
+class SpscQueue final {
+public:
+    /// Constructs the queue able to hold \p capacity items
+    explicit SpscQueue(const Size capacity)
+        : mSlotCount(capacity + 1)
+        , mSlots(new T[capacity + 1]) {
+        ASSERT(capacity > 0);
+    }
+
+    /// Appends the item, returns false if the queue is full. May only be called by the producer thread.
+    bool tryPush(T item) {
+        const Size tail = mTail.load(std::memory_order_relaxed);
+        const Size next = (tail + 1) % mSlotCount;
+        if (next == mHead.load(std::memory_order_acquire)) {
+            return false;
+        }
+        mSlots[tail] = std::move(item);
+        mTail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /// Removes the oldest item, returns false if the queue is empty. May only be called by the consumer
+    /// thread.
+    bool tryPop(T& item) {
+        const Size head = mHead.load(std::memory_order_relaxed);
+        if (head == mTail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = std::move(mSlots[head]);
+        mHead.store((head + 1) % mSlotCount, std::memory_order_release);
+        return true;
+    }
+
+private:
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    static constexpr Size CACHE_LINE_SIZE = 64;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<Size> mHead{ 0 };
+    alignas(CACHE_LINE_SIZE) std::atomic<Size> mTail{ 0 };
+    alignas(CACHE_LINE_SIZE) const Size mSlotCount;
+    std::unique_ptr<T[]> mSlots;
+};
+
+} // namespace crypto
+
+#endif // CPPLIBCRYPTO_COMMON_SPSCQUEUE_H_
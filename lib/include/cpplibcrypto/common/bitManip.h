@@ -25,6 +25,54 @@ inline constexpr T rotateRight(const T value, const Byte bits) {
     return (value >> bits) | (value << (8 * sizeof(T) - bits));
 }
 
+/// Reads a big-endian value from the given memory
+///
+/// \param in Pointer to at least sizeof(T) bytes
+/// \returns The value in the native byte order
+template <typename T>
+inline constexpr T loadBigEndian(const Byte* in) {
+    T value = 0;
+    for (Size i = 0; i < sizeof(T); ++i) {
+        value = (value << 8) | in[i];
+    }
+    return value;
+}
+
+/// Writes the given value to the memory in big-endian byte order
+///
+/// \param out Pointer to at least sizeof(T) bytes
+/// \param value The value to write
+template <typename T>
+inline constexpr void storeBigEndian(Byte* out, const T value) {
+    for (Size i = 0; i < sizeof(T); ++i) {
+        out[i] = static_cast<Byte>(value >> 8 * (sizeof(T) - 1 - i));
+    }
+}
+
+/// Reads a little-endian value from the given memory
+///
+/// \param in Pointer to at least sizeof(T) bytes
+/// \returns The value in the native byte order
+template <typename T>
+inline constexpr T loadLittleEndian(const Byte* in) {
+    T value = 0;
+    for (Size i = sizeof(T); i > 0; --i) {
+        value = (value << 8) | in[i - 1];
+    }
+    return value;
+}
+
+/// Writes the given value to the memory in little-endian byte order
+///
+/// \param out Pointer to at least sizeof(T) bytes
+/// \param value The value to write
+template <typename T>
+inline constexpr void storeLittleEndian(Byte* out, const T value) {
+    for (Size i = 0; i < sizeof(T); ++i) {
+        out[i] = static_cast<Byte>(value >> 8 * i);
+    }
+}
+
 } // namespace crypto::bits
 
 #endif // CPPLIBCRYPTO_COMMON_BITMANIP_H_
@@ -53,10 +53,13 @@ private:
 
 /// RFC 2104 HMAC implementation.
 /// Computes a digest based on the given underlying hashing algorithm.
+///
+/// The key padded with ipad and opad is compressed only once, when the key is set. The resulting hash states
+/// are kept and each digest starts from them, costing only the message blocks plus one outer block.
 template <typename THash>
 class Hmac : public SymmetricAlgorithm {
 public:
-    static constexpr Size BLOCK_SIZE = 64U;
+    static constexpr Size BLOCK_SIZE = THash::BLOCK_SIZE;
     static constexpr Size DIGEST_SIZE = THash::DIGEST_SIZE;
 
     Hmac() = default;
@@ -69,7 +72,8 @@ public:
     Hmac(Hmac&& other) { *this = std::move(other); }
 
     Hmac& operator=(Hmac&& other) {
-        std::swap(mDerivedKey, other.mDerivedKey);
+        std::swap(mInnerState, other.mInnerState);
+        std::swap(mOuterState, other.mOuterState);
         std::swap(mHasher, other.mHasher);
         std::swap(mKeySet, other.mKeySet);
         return *this;
@@ -83,15 +87,14 @@ public:
                 "HMAC: The digest already has been computed. Reset the state to compute another digest.");
         }
         SymmetricAlgorithm::setKey(key);
-        updateKey();
+        mHasher.setState(mInnerState, BLOCK_SIZE);
         mKeySet = true;
     }
 
     /// Resets the state
     /// After calling this function, new digest can be computed using the same instance of this object
     void reset() {
-        mHasher.reset();
-        updateKey();
+        mHasher.setState(mInnerState, BLOCK_SIZE);
         mFinalized = false;
     }
 
@@ -114,7 +117,6 @@ public:
     /// \throws Exception if \ref finalize() has already been called
     template <typename TOut>
     void finalize(TOut& out) {
-        ASSERT(mDerivedKey.size() == BLOCK_SIZE);
         if (mFinalized) {
             throw Exception(
                 "HMAC: The digest already has been computed. Reset the state to compute another digest.");
@@ -122,47 +124,57 @@ public:
         StaticBuffer<Byte, DIGEST_SIZE> digest(DIGEST_SIZE);
         mHasher.finalize(digest);
 
-        ByteBuffer oKeyPad;
-        for (Size i = 0; i < BLOCK_SIZE; ++i) {
-            oKeyPad.push(mDerivedKey[i] ^ 0x5c);
-        }
-        mHasher.reset();
-        mHasher.update(oKeyPad);
+        mHasher.setState(mOuterState, BLOCK_SIZE);
         mHasher.update(digest);
         mHasher.finalize(out);
         mFinalized = true;
     }
 
+    using HashState = typename THash::HashState;
+
+    /// Returns the hash state after compressing the key XORed with ipad
+    const HashState& getInnerState() const { return mInnerState; }
+
+    /// Returns the hash state after compressing the key XORed with opad
+    const HashState& getOuterState() const { return mOuterState; }
+
 private:
     Hmac& operator=(const Hmac&) = delete;
     Hmac(const Hmac&) = delete;
 
-    void updateKey() {
-        ASSERT(mDerivedKey.size() == BLOCK_SIZE);
-        ByteBuffer iKeyPad;
-        for (Size i = 0; i < BLOCK_SIZE; ++i) {
-            iKeyPad.push(mDerivedKey[i] ^ 0x36);
-        }
-        mHasher.reset();
-        mHasher.update(iKeyPad);
-    }
-
     void keySchedule(const ConstByteBufferSlice& key) override {
-        mDerivedKey.clear();
+        StaticBuffer<Byte, BLOCK_SIZE> derivedKey;
         if (key.size() > BLOCK_SIZE) {
             mHasher.reset();
             mHasher.update(key);
             ASSERT(DIGEST_SIZE <= BLOCK_SIZE);
-            mDerivedKey.resize(DIGEST_SIZE);
-            mHasher.finalize(mDerivedKey);
+            derivedKey.resize(DIGEST_SIZE);
+            mHasher.finalize(derivedKey);
         } else {
-            mDerivedKey.insert(mDerivedKey.end(), key.begin(), key.end());
+            derivedKey.insert(derivedKey.end(), key.begin(), key.end());
+        }
+        derivedKey.insert(derivedKey.end(), 0x00, BLOCK_SIZE - derivedKey.size());
+        ASSERT(derivedKey.size() == BLOCK_SIZE);
+
+        mInnerState = computePadState(derivedKey, 0x36);
+        mOuterState = computePadState(derivedKey, 0x5c);
+    }
+
+    /// Returns the hash state after compressing the key XORed with the given pad byte
+    HashState computePadState(StaticBuffer<Byte, BLOCK_SIZE>& derivedKey, const Byte pad) {
+        for (Byte& b : derivedKey) {
+            b ^= pad;
+        }
+        mHasher.reset();
+        mHasher.update(derivedKey);
+        for (Byte& b : derivedKey) {
+            b ^= pad;
         }
-        mDerivedKey.insert(mDerivedKey.end(), 0x00, BLOCK_SIZE - mDerivedKey.size());
-        ASSERT(mDerivedKey.size() == BLOCK_SIZE);
+        return mHasher.getState();
     }
 
-    StaticBuffer<Byte, BLOCK_SIZE> mDerivedKey;
+    HashState mInnerState;
+    HashState mOuterState;
     THash mHasher;
     bool mKeySet = false;
     bool mFinalized = false;
@@ -6,7 +6,9 @@
 #include "cpplibcrypto/common/Exception.h"
 #include "cpplibcrypto/common/bitManip.h"
 
+#include <algorithm>
 #include <cstring>
+#include <limits>
 
 namespace crypto {
 
@@ -23,6 +25,16 @@ public:
 
         State() { reset(); }
 
+        State(const State& other) { *this = other; }
+
+        State& operator=(const State& other) {
+            if (this != &other) {
+                H.clear();
+                H << other.H;
+            }
+            return *this;
+        }
+
         State(State&& other) { *this = std::move(other); }
 
         State& operator=(State&& other) {
@@ -41,12 +53,10 @@ public:
             H.push(0x98BADCFE);
             H.push(0x10325476);
         }
-
-    private:
-        State(const State&) = delete;
-        State& operator=(const State&) = delete;
     };
 
+    using HashState = State;
+
     Md5() { reset(); }
 
     Md5(Md5&& other) { *this = std::move(other); }
@@ -59,6 +69,23 @@ public:
         return *this;
     }
 
+    State& getState() { return mState; }
+
+    void setState(State state) { mState = std::move(state); }
+
+    /// Restarts the computation from an intermediate state
+    ///
+    /// The pending data and the finalized flag are cleared, making the object ready to accept more input.
+    /// \param state The state captured by \ref getState() after compressing \p totalSize bytes
+    /// \param totalSize The number of bytes compressed into \p state, must be a multiple of BLOCK_SIZE
+    void setState(const State& state, const Qword totalSize) {
+        ASSERT(totalSize % BLOCK_SIZE == 0);
+        mState = state;
+        mTotalSize = totalSize;
+        mBlock.clear();
+        mFinalized = false;
+    }
+
     /// Resets the state to the default, making it ready to compute another digest
     void reset() {
         mFinalized = false;
@@ -72,24 +99,44 @@ public:
     /// 2^64 bytes.
     template <typename TBuffer>
     void update(const TBuffer& in) {
+        static_assert(sizeof(*in.data()) == 1, "The input buffer elements must be bytes");
+        update(reinterpret_cast<const Byte*>(in.data()), in.size());
+    }
+
+    /// Updates the state with the given data
+    ///
+    /// Whole blocks are compressed straight from \p in, only the trailing partial block gets buffered.
+    /// \param in The data to hash
+    /// \param size The number of bytes in \p in
+    /// \throws Exception if the \ref finalize() has already been called or if the overall input size exceeded
+    /// 2^64 bytes.
+    void update(const Byte* in, Size size) {
         if (mFinalized) {
             throw Exception(
                 "MD5: The state already has been computed. Reset the state to compute another digest.");
         }
-        for (const Byte b : in) {
-            mBlock.push(b);
-
-            ++mTotalSize;
-            // Overflowed
-            if (mTotalSize == 0) {
-                throw Exception("MD5: Input is too long");
-            }
-
-            if (mBlock.size() == BLOCK_SIZE) {
-                processBlock(mBlock);
-                mBlock.clear();
+        if (size > std::numeric_limits<Qword>::max() - mTotalSize) {
+            throw Exception("MD5: Input is too long");
+        }
+        mTotalSize += size;
+
+        if (!mBlock.empty()) {
+            const Size toFill = std::min(size, BLOCK_SIZE - mBlock.size());
+            mBlock.insert(mBlock.end(), in, in + toFill);
+            in += toFill;
+            size -= toFill;
+            if (mBlock.size() < BLOCK_SIZE) {
+                return;
             }
+            processBlock(mState, mBlock.data());
+            mBlock.clear();
         }
+
+        const Size nBlocks = size / BLOCK_SIZE;
+        processBlocks(mState, in, nBlocks);
+        in += nBlocks * BLOCK_SIZE;
+        size -= nBlocks * BLOCK_SIZE;
+        mBlock.insert(mBlock.end(), in, in + size);
     }
 
     /// Finalizes the digest computation, outputs the result to the given buffer
@@ -108,12 +155,45 @@ public:
         mFinalized = true;
     }
 
+    /// Compresses consecutive blocks into the given state
+    ///
+    /// \param state The state to update
+    /// \param in The data, BLOCK_SIZE * nBlocks bytes
+    /// \param nBlocks The number of blocks
+    static void processBlocks(State& state, const Byte* in, const Size nBlocks) {
+        for (Size block = 0; block < nBlocks; ++block) {
+            processBlock(state, in + block * BLOCK_SIZE);
+        }
+    }
+
+    /// Outputs the digest held by the given state
+    /// \param state The state after compressing the last block
+    /// \param out Output buffer, must be at least \ref Md5::DIGEST_SIZE long
+    template <typename TOut>
+    static void encodeDigest(const State& state, TOut&& out) {
+        encode(out, state.H);
+    }
+
+    /// Pads the last block of a message in place
+    /// \param block The block whose first \p used bytes hold the end of the message
+    /// \param used The number of message bytes in the block, the padding byte and the length must fit after
+    /// them
+    /// \param totalSize The size of the whole message in bytes
+    static void padFinalBlock(Byte* block, const Size used, const Qword totalSize) {
+        ASSERT(used + 1 + 8 <= BLOCK_SIZE);
+        block[used] = 0x80;
+        std::fill(block + used + 1, block + BLOCK_SIZE - 8, Byte(0));
+        const Qword totalBits = totalSize << 3;
+        for (Byte i = 0; i < 8; ++i) {
+            block[BLOCK_SIZE - 8 + i] = Byte(totalBits >> 8 * i);
+        }
+    }
+
 private:
     Md5(const Md5&) = delete;
     Md5& operator=(const Md5&) = delete;
 
-    void processBlock(BufferSlice<const Byte> in) {
-        ASSERT(in.size() == BLOCK_SIZE);
+    static void processBlock(State& state, const Byte* in) {
         static const StaticBuffer<Dword, 64>
             constantsArray({ 0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a,
                              0xa8304613, 0xfd469501, 0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be,
@@ -134,14 +214,14 @@ private:
               4,  11, 16, 23, 6,  10, 15, 21, 6,  10, 15, 21, 6,  10, 15, 21, 6,  10, 15, 21 });
 
         Dword A, B, C, D, F;
-        A = mState[0];
-        B = mState[1];
-        C = mState[2];
-        D = mState[3];
+        A = state[0];
+        B = state[1];
+        C = state[2];
+        D = state[3];
         F = 0;
 
         StaticBuffer<Dword, 16> block(16);
-        decode(block, in);
+        decode(block, BufferSlice<const Byte>(in, in + BLOCK_SIZE));
 
         Byte g = 0;
         for (unsigned int i = 0; i < 64; ++i) {
@@ -166,10 +246,10 @@ private:
             A = temp;
         }
 
-        mState[0] += A;
-        mState[1] += B;
-        mState[2] += C;
-        mState[3] += D;
+        state[0] += A;
+        state[1] += B;
+        state[2] += C;
+        state[3] += D;
     }
 
     void padBlock() {
@@ -178,7 +258,7 @@ private:
         if (mBlock.size() > 56U) {
             mBlock.insert(mBlock.end(), 0x00, BLOCK_SIZE - mBlock.size());
             ASSERT(mBlock.size() == BLOCK_SIZE);
-            processBlock(mBlock);
+            processBlock(mState, mBlock.data());
             mBlock.clear();
         }
         mBlock.insert(mBlock.end(), 0x00, 56U - mBlock.size());
@@ -190,12 +270,12 @@ private:
             mBlock.push(totalBitsPtr[i]);
         }
         ASSERT(mBlock.size() == BLOCK_SIZE);
-        processBlock(mBlock);
+        processBlock(mState, mBlock.data());
         mBlock.clear();
     }
 
     template <typename TBuffer>
-    static void encode(TBuffer& out, BufferSlice<const Dword> in) {
+    static void encode(TBuffer&& out, BufferSlice<const Dword> in) {
         for (Size i = 0; i < in.size(); i++) {
             out[i << 2] = in[i] & 0xff;
             out[(i << 2) + 1] = (in[i] >> 8) & 0xff;
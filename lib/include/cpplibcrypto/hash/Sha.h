@@ -6,6 +6,11 @@
 #include "cpplibcrypto/common/AnyOf.h"
 #include "cpplibcrypto/common/Exception.h"
 #include "cpplibcrypto/common/bitManip.h"
+#include "cpplibcrypto/hash/Sha512Avx2.h"
+#include "cpplibcrypto/hash/ShaNi.h"
+
+#include <algorithm>
+#include <limits>
 
 namespace crypto::sha {
 
@@ -25,44 +30,109 @@ constexpr Dword bigSigma1(const Dword v) {
     return bits::rotateRight(v, 6) ^ bits::rotateRight(v, 11) ^ bits::rotateRight(v, 25);
 }
 
-constexpr Dword choose(const Dword x, const Dword y, const Dword z) {
+constexpr Qword sigma0(const Qword v) {
+    return bits::rotateRight(v, 1) ^ bits::rotateRight(v, 8) ^ (v >> 7);
+}
+
+constexpr Qword sigma1(const Qword v) {
+    return bits::rotateRight(v, 19) ^ bits::rotateRight(v, 61) ^ (v >> 6);
+}
+
+constexpr Qword bigSigma0(const Qword v) {
+    return bits::rotateRight(v, 28) ^ bits::rotateRight(v, 34) ^ bits::rotateRight(v, 39);
+}
+
+constexpr Qword bigSigma1(const Qword v) {
+    return bits::rotateRight(v, 14) ^ bits::rotateRight(v, 18) ^ bits::rotateRight(v, 41);
+}
+
+template <typename T>
+constexpr T choose(const T x, const T y, const T z) {
     // Does "x ? y : z" for each bit
     return (x & y) ^ (~x & z);
 }
 
-constexpr Dword majority(const Dword x, const Dword y, const Dword z) {
+template <typename T>
+constexpr T majority(const T x, const T y, const T z) {
     return (x & y) ^ (x & z) ^ (y & z);
 }
 
-enum class Family { SHA1, SHA224, SHA256, SHA384, SHA512 };
+enum class Family { SHA1, SHA224, SHA256, SHA384, SHA512, SHA512_256 };
+
+/// Returns true for the families working with 64-bit words and 128 byte blocks
+constexpr bool isWide(const Family family) {
+    return family == anyOf(Family::SHA384, Family::SHA512, Family::SHA512_256);
+}
+
+/// Implementation of the compression function
+enum class Implementation {
+    /// Portable implementation
+    Portable,
+    /// Hardware implementation using the Intel SHA extensions, see \ref ShaNi. SHA-1 and SHA-224/256 only.
+    ShaNi,
+    /// Message schedule computed with AVX2, see \ref Sha512Avx2. SHA-384 and SHA-512 variants only.
+    Avx2,
+};
+
+/// Returns true if the given implementation exists for the given family
+constexpr bool isApplicable(const Family family, const Implementation implementation) {
+    switch (implementation) {
+    case Implementation::ShaNi:
+        return !isWide(family);
+    case Implementation::Avx2:
+        return isWide(family);
+    default:
+        return true;
+    }
+}
+
+/// Returns true if the given implementation can be used on this CPU
+inline bool isSupported(const Implementation implementation) {
+    switch (implementation) {
+    case Implementation::ShaNi:
+        return ShaNi::isSupported();
+    case Implementation::Avx2:
+        return Sha512Avx2::isSupported();
+    default:
+        return true;
+    }
+}
+
+/// Returns the fastest implementation of the given family supported on this CPU
+template <Family TFamily>
+inline Implementation getDefaultImplementation() {
+    static const Implementation implementation = [] {
+        for (const Implementation candidate : { Implementation::ShaNi, Implementation::Avx2 }) {
+            if (isApplicable(TFamily, candidate) && isSupported(candidate)) {
+                return candidate;
+            }
+        }
+        return Implementation::Portable;
+    }();
+    return implementation;
+}
 
 template <Family TFamily>
 struct State {
-    using Word =
-        Conditional<TFamily == anyOf(Family::SHA1, Family::SHA224, Family::SHA256), Dword, Qword>;
+    using Word = Conditional<isWide(TFamily), Qword, Dword>;
 
-    static constexpr Size getBlockSize() {
-        switch (TFamily) {
-        case Family::SHA1:
-            return 20;
-        case Family::SHA224:
-            [[fallthrough]];
-        case Family::SHA256:
-            return 32;
-        case Family::SHA384:
-            [[fallthrough]];
-        case Family::SHA512:
-            return 64;
-        default:
-            ASSERT(false);
-            throw Exception("Invalid SHA family");
-        }
-    }
+    /// The number of words of the state
+    static constexpr Size WORD_COUNT = TFamily == Family::SHA1 ? 5 : 8;
 
-    StaticBuffer<Word, getBlockSize() / 4> H;
+    StaticBuffer<Word, WORD_COUNT> H;
 
     State() { reset(); }
 
+    State(const State& other) { *this = other; }
+
+    State& operator=(const State& other) {
+        if (this != &other) {
+            H.clear();
+            H << other.H;
+        }
+        return *this;
+    }
+
     State(State&& other) { *this = std::move(other); }
 
     State& operator=(State&& other) {
@@ -123,14 +193,20 @@ struct State {
             H.push(0x9b05688c2b3e6c1fULL);
             H.push(0x1f83d9abfb41bd6bULL);
             H.push(0x5be0cd19137e2179ULL);
+        } else if constexpr (TFamily == Family::SHA512_256) {
+            // Constants defined in FIPS 180-4, section 5.3.6.2
+            H.push(0x22312194fc2bf72cULL);
+            H.push(0x9f555fa3c84c64c2ULL);
+            H.push(0x2393b86b6f53b151ULL);
+            H.push(0x963877195940eabdULL);
+            H.push(0x96283ee2a88effe3ULL);
+            H.push(0xbe5e1e2553863992ULL);
+            H.push(0x2b0199fc2c85b8aaULL);
+            H.push(0x0eb72ddc81c52ca2ULL);
         } else {
             throw Exception("Invalid SHA family");
         }
     }
-
-private:
-    State(const State&) = delete;
-    State& operator=(const State&) = delete;
 };
 
 template <Family TFamily>
@@ -147,6 +223,8 @@ class Sha {
             return 384 / 8;
         case Family::SHA512:
             return 512 / 8;
+        case Family::SHA512_256:
+            return 256 / 8;
         default:
             ASSERT(false);
             throw Exception("Invalid SHA family");
@@ -154,7 +232,10 @@ class Sha {
     }
 
 public:
-    static constexpr Size BLOCK_SIZE = 64U;
+    using HashState = State<TFamily>;
+    using Word = typename State<TFamily>::Word;
+
+    static constexpr Size BLOCK_SIZE = isWide(TFamily) ? 128U : 64U;
     static constexpr Size DIGEST_SIZE = getDigestSize();
 
     virtual ~Sha() noexcept = default;
@@ -174,24 +255,46 @@ public:
     /// 2^64 bytes.
     template <typename TBuffer>
     void update(const TBuffer& in) {
+        static_assert(sizeof(*in.data()) == 1, "The input buffer elements must be bytes");
+        update(reinterpret_cast<const Byte*>(in.data()), in.size());
+    }
+
+    /// Updates the state with the given data
+    ///
+    /// Whole blocks are compressed straight from \p in, only the trailing partial block gets buffered.
+    /// \param in The data to hash
+    /// \param size The number of bytes in \p in
+    /// \throws Exception if the \ref finalize() has already been called or if the overall input size exceeded
+    /// 2^64 bytes.
+    void update(const Byte* in, Size size) {
         if (mFinalized) {
             throw Exception(
                 "SHA: The state already has been computed. Reset the state to compute another digest.");
         }
-        for (const Byte b : in) {
-            mBlock.push(b);
-
-            ++mTotalSize;
-            // Overflowed
-            if (mTotalSize == 0) {
-                throw Exception("SHA: Input is too long");
+        if (size > std::numeric_limits<Qword>::max() - mTotalSize) {
+            throw Exception("SHA: Input is too long");
+        }
+        mTotalSize += size;
+
+        if (!mBlock.empty()) {
+            const Size toFill = std::min(size, BLOCK_SIZE - mBlock.size());
+            mBlock.insert(mBlock.end(), in, in + toFill);
+            in += toFill;
+            size -= toFill;
+            if (mBlock.size() < BLOCK_SIZE) {
+                return;
             }
+            processBlocks(mBlock.data(), 1);
+            mBlock.clear();
+        }
 
-            if (mBlock.size() == BLOCK_SIZE) {
-                processBlock(mBlock);
-                mBlock.clear();
-            }
+        const Size nBlocks = size / BLOCK_SIZE;
+        if (nBlocks > 0) {
+            processBlocks(in, nBlocks);
+            in += nBlocks * BLOCK_SIZE;
+            size -= nBlocks * BLOCK_SIZE;
         }
+        mBlock.insert(mBlock.end(), in, in + size);
     }
 
     /// Finalizes the digest computation, outputs the result to the given buffer
@@ -206,16 +309,53 @@ public:
         padBlock();
         mTotalSize = 0;
 
+        encodeDigest(mState, out);
+        mFinalized = true;
+    }
+
+    /// Outputs the digest held by the given state
+    /// \param state The state after compressing the last block
+    /// \param out Output buffer, must be at least \ref Sha::DIGEST_SIZE long
+    template <typename TOut>
+    static void encodeDigest(const State<TFamily>& state, TOut&& out) {
         for (Size i = 0; i < DIGEST_SIZE; ++i) {
-            out[i] = mState[i >> 2] >> 8 * (3 - (i & 0x03));
+            out[i] = Byte(state[i / sizeof(Word)] >> 8 * (sizeof(Word) - 1 - i % sizeof(Word)));
         }
-        mFinalized = true;
+    }
+
+    /// Pads the last block of a message in place
+    /// \param block The block whose first \p used bytes hold the end of the message
+    /// \param used The number of message bytes in the block, the padding byte and the length must fit after
+    /// them
+    /// \param totalSize The size of the whole message in bytes
+    static void padFinalBlock(Byte* block, const Size used, const Qword totalSize) {
+        constexpr Size LENGTH_SIZE = BLOCK_SIZE / 8;
+        ASSERT(used + 1 + LENGTH_SIZE <= BLOCK_SIZE);
+        block[used] = 0x80;
+        std::fill(block + used + 1, block + BLOCK_SIZE - 8, Byte(0));
+        if constexpr (LENGTH_SIZE == 16) {
+            bits::storeBigEndian(block + BLOCK_SIZE - 16, Qword(totalSize >> 61));
+        }
+        bits::storeBigEndian(block + BLOCK_SIZE - 8, Qword(totalSize << 3));
     }
 
     State<TFamily>& getState() { return mState; }
 
     void setState(State<TFamily> state) { mState = std::move(state); }
 
+    /// Restarts the computation from an intermediate state
+    ///
+    /// The pending data and the finalized flag are cleared, making the object ready to accept more input.
+    /// \param state The state captured by \ref getState() after compressing \p totalSize bytes
+    /// \param totalSize The number of bytes compressed into \p state, must be a multiple of BLOCK_SIZE
+    void setState(const State<TFamily>& state, const Qword totalSize) {
+        ASSERT(totalSize % BLOCK_SIZE == 0);
+        mState = state;
+        mTotalSize = totalSize;
+        mBlock.clear();
+        mFinalized = false;
+    }
+
     void reset() {
         mFinalized = false;
         mTotalSize = 0;
@@ -226,27 +366,31 @@ public:
 protected:
     Sha() { reset(); }
 
-    virtual void processBlock(BufferSlice<const Byte> in) = 0;
+    /// Compresses consecutive BLOCK_SIZE byte blocks into \ref mState
+    virtual void processBlocks(const Byte* in, Size nBlocks) = 0;
 
     void padBlock() {
         ASSERT(mBlock.size() < BLOCK_SIZE);
+        // The message length in bits is stored in the last 8 (64 byte blocks) or 16 (128 byte blocks) bytes
+        constexpr Size LENGTH_SIZE = BLOCK_SIZE / 8;
         mBlock.push(0x80);
-        if (mBlock.size() > 56U) {
+        if (mBlock.size() > BLOCK_SIZE - LENGTH_SIZE) {
             mBlock.insert(mBlock.end(), 0x00, BLOCK_SIZE - mBlock.size());
             ASSERT(mBlock.size() == BLOCK_SIZE);
-            processBlock(mBlock);
+            processBlocks(mBlock.data(), 1);
             mBlock.clear();
         }
-        mBlock.insert(mBlock.end(), 0x00, 56U - mBlock.size());
-        ASSERT(mBlock.size() == 56U);
+        mBlock.insert(mBlock.end(), 0x00, BLOCK_SIZE - LENGTH_SIZE - mBlock.size());
+        ASSERT(mBlock.size() == BLOCK_SIZE - LENGTH_SIZE);
 
-        const Qword totalBits = mTotalSize * 8;
-        const Byte* totalBitsPtr = reinterpret_cast<const Byte*>(&totalBits);
-        for (int i = 7; i >= 0; --i) {
-            mBlock.push(totalBitsPtr[i]);
+        Byte totalBits[LENGTH_SIZE] = {};
+        if constexpr (LENGTH_SIZE == 16) {
+            bits::storeBigEndian(totalBits, Qword(mTotalSize >> 61));
         }
+        bits::storeBigEndian(totalBits + LENGTH_SIZE - 8, Qword(mTotalSize << 3));
+        mBlock.insert(mBlock.end(), totalBits, totalBits + LENGTH_SIZE);
         ASSERT(mBlock.size() == BLOCK_SIZE);
-        processBlock(mBlock);
+        processBlocks(mBlock.data(), 1);
         mBlock.clear();
     }
 
@@ -2,7 +2,6 @@
 #define CPPLIBCRYPTO_HASH_SHA1_H_
 
 #include "cpplibcrypto/buffer/BufferSlice.h"
-#include "cpplibcrypto/buffer/StaticBuffer.h"
 #include "cpplibcrypto/common/Exception.h"
 #include "cpplibcrypto/common/bitManip.h"
 #include "cpplibcrypto/hash/Sha.h"
@@ -19,34 +18,70 @@ public:
     Sha1(Sha1&& other) = default;
     Sha1& operator=(Sha1&& other) = default;
 
+    /// Compresses consecutive blocks into the given state
+    ///
+    /// Uses the fastest implementation supported by the CPU.
+    /// \param state The state to update
+    /// \param in The data, BLOCK_SIZE * nBlocks bytes
+    /// \param nBlocks The number of blocks
+    static void processBlocks(sha::State<sha::Family::SHA1>& state, const Byte* in, const Size nBlocks) {
+        processBlocks(state, in, nBlocks, sha::getDefaultImplementation<sha::Family::SHA1>());
+    }
+
+    /// Compresses consecutive blocks into the given state using the given implementation
+    ///
+    /// \param state The state to update
+    /// \param in The data, BLOCK_SIZE * nBlocks bytes
+    /// \param nBlocks The number of blocks
+    /// \param implementation The implementation to use, must be supported by the CPU
+    static void processBlocks(sha::State<sha::Family::SHA1>& state,
+                              const Byte* in,
+                              const Size nBlocks,
+                              const sha::Implementation implementation) {
+        ASSERT(sha::isApplicable(sha::Family::SHA1, implementation) && sha::isSupported(implementation));
+        if (implementation == sha::Implementation::ShaNi) {
+            ShaNi::sha1ProcessBlocks(state.H.data(), in, nBlocks);
+            return;
+        }
+        for (Size block = 0; block < nBlocks; ++block) {
+            processBlockPortable(state, in + block * BLOCK_SIZE);
+        }
+    }
+
 private:
     Sha1(const Sha1&) = delete;
     Sha1& operator=(const Sha1&) = delete;
 
-    virtual void processBlock(BufferSlice<const Byte> in) override {
+    virtual void processBlocks(const Byte* in, const Size nBlocks) override {
+        processBlocks(mState, in, nBlocks);
+    }
+
+    static void processBlockPortable(sha::State<sha::Family::SHA1>& state, const Byte* in) {
         // Constants defined in FIPS 181-4, section 4.2.1
-        static const StaticBuffer<Dword, 4> K({ 0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xCA62C1D6 });
+        static constexpr Dword K[4] = { 0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xCA62C1D6 };
 
-        StaticBuffer<Dword, 80> W(80);
+        // The message schedule only ever needs the last 16 words
+        Dword W[16];
         for (int t = 0; t < 16; t++) {
-            W[t] = in[t * 4] << 24;
-            W[t] |= in[t * 4 + 1] << 16;
-            W[t] |= in[t * 4 + 2] << 8;
-            W[t] |= in[t * 4 + 3];
+            W[t] = bits::loadBigEndian<Dword>(in + t * 4);
         }
 
-        for (int t = 16; t < 80; t++) {
-            W[t] = bits::rotateLeft(W[t - 3] ^ W[t - 8] ^ W[t - 14] ^ W[t - 16], 1);
-        }
+        Dword A = state[0];
+        Dword B = state[1];
+        Dword C = state[2];
+        Dword D = state[3];
+        Dword E = state[4];
 
-        Dword A = mState[0];
-        Dword B = mState[1];
-        Dword C = mState[2];
-        Dword D = mState[3];
-        Dword E = mState[4];
+        const auto schedule = [&W](const int t) {
+            if (t >= 16) {
+                W[t & 15] =
+                    bits::rotateLeft(W[(t - 3) & 15] ^ W[(t - 8) & 15] ^ W[(t - 14) & 15] ^ W[t & 15], 1);
+            }
+            return W[t & 15];
+        };
 
         for (int t = 0; t < 20; t++) {
-            const Dword temp = bits::rotateLeft(A, 5) + ((B & C) | ((~B) & D)) + E + W[t] + K[0];
+            const Dword temp = bits::rotateLeft(A, 5) + ((B & C) | ((~B) & D)) + E + schedule(t) + K[0];
             E = D;
             D = C;
             C = bits::rotateLeft(B, 30);
@@ -55,7 +90,7 @@ private:
         }
 
         for (int t = 20; t < 40; t++) {
-            const Dword temp = bits::rotateLeft(A, 5) + (B ^ C ^ D) + E + W[t] + K[1];
+            const Dword temp = bits::rotateLeft(A, 5) + (B ^ C ^ D) + E + schedule(t) + K[1];
             E = D;
             D = C;
             C = bits::rotateLeft(B, 30);
@@ -64,7 +99,8 @@ private:
         }
 
         for (int t = 40; t < 60; t++) {
-            const Dword temp = bits::rotateLeft(A, 5) + ((B & C) | (B & D) | (C & D)) + E + W[t] + K[2];
+            const Dword temp =
+                bits::rotateLeft(A, 5) + ((B & C) | (B & D) | (C & D)) + E + schedule(t) + K[2];
             E = D;
             D = C;
             C = bits::rotateLeft(B, 30);
@@ -73,7 +109,7 @@ private:
         }
 
         for (int t = 60; t < 80; t++) {
-            const Dword temp = bits::rotateLeft(A, 5) + (B ^ C ^ D) + E + W[t] + K[3];
+            const Dword temp = bits::rotateLeft(A, 5) + (B ^ C ^ D) + E + schedule(t) + K[3];
             E = D;
             D = C;
             C = bits::rotateLeft(B, 30);
@@ -81,11 +117,11 @@ private:
             A = temp;
         }
 
-        mState[0] += A;
-        mState[1] += B;
-        mState[2] += C;
-        mState[3] += D;
-        mState[4] += E;
+        state[0] += A;
+        state[1] += B;
+        state[2] += C;
+        state[3] += D;
+        state[4] += E;
     }
 };
 
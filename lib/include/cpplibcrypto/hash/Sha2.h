@@ -8,6 +8,46 @@
 
 namespace crypto {
 
+namespace sha {
+
+// Constants defined in FIPS 180-4, section 4.2.2
+static constexpr Dword sha256K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+// Constants defined in FIPS 180-4, section 4.2.3
+static constexpr Qword sha512K[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL,
+};
+
+} // namespace sha
+
 template <sha::Family TFamily>
 class Sha2 final : public sha::Sha<TFamily> {
 public:
@@ -16,50 +56,86 @@ public:
     Sha2(Sha2&& other) = default;
     Sha2& operator=(Sha2&& other) = default;
 
+    /// Compresses consecutive blocks into the given state
+    ///
+    /// Uses the fastest implementation supported by the CPU.
+    /// \param state The state to update
+    /// \param in The data, BLOCK_SIZE * nBlocks bytes
+    /// \param nBlocks The number of blocks
+    static void processBlocks(sha::State<TFamily>& state, const Byte* in, const Size nBlocks) {
+        processBlocks(state, in, nBlocks, sha::getDefaultImplementation<TFamily>());
+    }
+
+    /// Compresses consecutive blocks into the given state using the given implementation
+    ///
+    /// \param state The state to update
+    /// \param in The data, BLOCK_SIZE * nBlocks bytes
+    /// \param nBlocks The number of blocks
+    /// \param implementation The implementation to use, must be supported by the CPU
+    static void processBlocks(sha::State<TFamily>& state,
+                              const Byte* in,
+                              const Size nBlocks,
+                              const sha::Implementation implementation) {
+        ASSERT(sha::isApplicable(TFamily, implementation) && sha::isSupported(implementation));
+        if constexpr (sha::isWide(TFamily)) {
+            if (implementation == sha::Implementation::Avx2) {
+                Sha512Avx2::processBlocks(state.H.data(), in, nBlocks);
+                return;
+            }
+        } else {
+            if (implementation == sha::Implementation::ShaNi) {
+                ShaNi::sha256ProcessBlocks(state.H.data(), in, nBlocks);
+                return;
+            }
+        }
+        for (Size block = 0; block < nBlocks; ++block) {
+            processBlockPortable(state, in + block * sha::Sha<TFamily>::BLOCK_SIZE);
+        }
+    }
+
 private:
     Sha2(const Sha2&) = delete;
     Sha2& operator=(const Sha2&) = delete;
 
-    virtual void processBlock(BufferSlice<const Byte> in) override {
-        // Constants defined in FIPS 180-4, section 4.2.2
-        static const StaticBuffer<Dword, 64> K({ 0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b,
-                                                 0x59f111f1, 0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01,
-                                                 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7,
-                                                 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
-                                                 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152,
-                                                 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
-                                                 0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc,
-                                                 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
-                                                 0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819,
-                                                 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116, 0x1e376c08,
-                                                 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f,
-                                                 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
-                                                 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2 });
-
-        StaticBuffer<Dword, 64> W(64);
-        for (int t = 0; t < 16; t++) {
-            W[t] = in[t * 4] << 24;
-            W[t] |= in[t * 4 + 1] << 16;
-            W[t] |= in[t * 4 + 2] << 8;
-            W[t] |= in[t * 4 + 3];
+    virtual void processBlocks(const Byte* in, const Size nBlocks) override {
+        processBlocks(this->mState, in, nBlocks);
+    }
+
+    using Word = typename sha::State<TFamily>::Word;
+
+    /// 64 rounds for the 32-bit variants, 80 for the 64-bit ones
+    static constexpr int ROUNDS = sha::isWide(TFamily) ? 80 : 64;
+
+    static constexpr Word getRoundConstant(const int t) {
+        if constexpr (sha::isWide(TFamily)) {
+            return sha::sha512K[t];
+        } else {
+            return sha::sha256K[t];
         }
+    }
 
-        for (int t = 16; t < 64; t++) {
-            W[t] = sha::sigma1(W[t - 2]) + W[t - 7] + sha::sigma0(W[t - 15]) + W[t - 16];
+    static void processBlockPortable(sha::State<TFamily>& state, const Byte* in) {
+        // The message schedule only ever needs the last 16 words
+        Word W[16];
+        for (int t = 0; t < 16; t++) {
+            W[t] = bits::loadBigEndian<Word>(in + t * sizeof(Word));
         }
 
-        Dword A = this->mState[0];
-        Dword B = this->mState[1];
-        Dword C = this->mState[2];
-        Dword D = this->mState[3];
-        Dword E = this->mState[4];
-        Dword F = this->mState[5];
-        Dword G = this->mState[6];
-        Dword H = this->mState[7];
-
-        for (int t = 0; t < 64; t++) {
-            const Dword temp1 = H + sha::bigSigma1(E) + sha::choose(E, F, G) + K[t] + W[t];
-            const Dword temp2 = sha::bigSigma0(A) + sha::majority(A, B, C);
+        Word A = state[0];
+        Word B = state[1];
+        Word C = state[2];
+        Word D = state[3];
+        Word E = state[4];
+        Word F = state[5];
+        Word G = state[6];
+        Word H = state[7];
+
+        for (int t = 0; t < ROUNDS; t++) {
+            if (t >= 16) {
+                W[t & 15] += sha::sigma1(W[(t - 2) & 15]) + W[(t - 7) & 15] + sha::sigma0(W[(t - 15) & 15]);
+            }
+            const Word temp1 = H + sha::bigSigma1(E) + sha::choose(E, F, G) + getRoundConstant(t) + W[t & 15];
+            const Word temp2 = sha::bigSigma0(A) + sha::majority(A, B, C);
             H = G;
             G = F;
             F = E;
@@ -70,14 +146,14 @@ private:
             A = temp1 + temp2;
         }
 
-        this->mState[0] += A;
-        this->mState[1] += B;
-        this->mState[2] += C;
-        this->mState[3] += D;
-        this->mState[4] += E;
-        this->mState[5] += F;
-        this->mState[6] += G;
-        this->mState[7] += H;
+        state[0] += A;
+        state[1] += B;
+        state[2] += C;
+        state[3] += D;
+        state[4] += E;
+        state[5] += F;
+        state[6] += G;
+        state[7] += H;
     }
 };
 
@@ -91,6 +167,21 @@ using Sha224 = Sha2<sha::Family::SHA224>;
 /// Computes 32 bytes digest
 using Sha256 = Sha2<sha::Family::SHA256>;
 
+/// SHA384 384-bit hasing algorithm
+///
+/// Computes 48 bytes digest
+using Sha384 = Sha2<sha::Family::SHA384>;
+
+/// SHA512 512-bit hasing algorithm
+///
+/// Computes 64 bytes digest
+using Sha512 = Sha2<sha::Family::SHA512>;
+
+/// SHA512/256 256-bit hasing algorithm, SHA512 truncated to 256 bits with its own initial state
+///
+/// Computes 32 bytes digest
+using Sha512_256 = Sha2<sha::Family::SHA512_256>;
+
 } // namespace crypto
 
 #endif // CPPLIBCRYPTO_HASH_SHA224_H_
@@ -0,0 +1,86 @@
+#ifndef CPPLIBCRYPTO_HASH_SHA256BATCH_H_
+#define CPPLIBCRYPTO_HASH_SHA256BATCH_H_
+
+#include "cpplibcrypto/buffer/DynamicBuffer.h"
+#include "cpplibcrypto/common/Exception.h"
+#include "cpplibcrypto/common/common.h"
+
+namespace crypto {
+
+/// Computes the SHA-256 digests of many independent messages at once
+///
+/// Every SIMD lane hashes a different message. A lane is refilled with the next message as soon as its
+/// message is finished, so messages of different lengths keep all the lanes busy. Pays off for batches of
+/// short messages, where a single SHA-256 stream can't make use of the vector units.
+class Sha256Batch final {
+public:
+    static constexpr Size BLOCK_SIZE = 64U;
+    static constexpr Size DIGEST_SIZE = 32U;
+
+    /// Implementation of the multi-buffer compression
+    enum class Implementation {
+        /// One message after another using \ref Sha256
+        Serial,
+        /// 8 lanes using AVX2
+        Avx2,
+        /// 16 lanes using AVX-512
+        Avx512,
+    };
+
+    /// Computes the digests of the given messages using the fastest implementation supported by the CPU
+    ///
+    /// \param messages Pointers to the messages
+    /// \param sizes The sizes of the messages in bytes
+    /// \param count The number of messages
+    /// \param digests Output for the digests, DIGEST_SIZE bytes per message in the order of the messages
+    static void hash(const Byte* const* messages, const Size* sizes, const Size count, Byte* digests) {
+        hash(messages, sizes, count, digests, getDefaultImplementation());
+    }
+
+    /// Computes the digests of the given messages using the given implementation
+    ///
+    /// \param messages Pointers to the messages
+    /// \param sizes The sizes of the messages in bytes
+    /// \param count The number of messages
+    /// \param digests Output for the digests, DIGEST_SIZE bytes per message in the order of the messages
+    /// \param implementation The implementation to use
+    /// \throws Exception if the implementation is not supported on this CPU
+    static void hash(const Byte* const* messages,
+                     const Size* sizes,
+                     Size count,
+                     Byte* digests,
+                     Implementation implementation);
+
+    /// Computes the digests of the given messages
+    ///
+    /// \param messages A container of buffers, each buffer providing data() and size()
+    /// \param digests Output for the digests, must hold DIGEST_SIZE bytes per message
+    template <typename TMessages, typename TOut>
+    static void hash(const TMessages& messages, TOut& digests) {
+        DynamicBuffer<const Byte*> pointers;
+        DynamicBuffer<Size> sizes;
+        for (const auto& message : messages) {
+            static_assert(sizeof(*message.data()) == 1, "The message elements must be bytes");
+            pointers.push(reinterpret_cast<const Byte*>(message.data()));
+            sizes.push(message.size());
+        }
+        ASSERT(digests.size() >= pointers.size() * DIGEST_SIZE);
+        hash(pointers.data(), sizes.data(), pointers.size(), digests.data());
+    }
+
+    /// Returns true if the given implementation can be used on this CPU
+    static bool isSupported(Implementation implementation);
+
+    /// Returns the fastest implementation supported on this CPU
+    static Implementation getDefaultImplementation();
+
+    /// Returns the number of messages the given implementation hashes at once
+    static Size getLaneCount(Implementation implementation);
+
+private:
+    Sha256Batch() = delete;
+};
+
+} // namespace crypto
+
+#endif // CPPLIBCRYPTO_HASH_SHA256BATCH_H_
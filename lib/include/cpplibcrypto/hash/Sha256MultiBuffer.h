@@ -0,0 +1,45 @@
+#ifndef CPPLIBCRYPTO_HASH_SHA256MULTIBUFFER_H_
+#define CPPLIBCRYPTO_HASH_SHA256MULTIBUFFER_H_
+
+#include "cpplibcrypto/common/common.h"
+
+namespace crypto {
+
+/// SHA-256 compression functions processing one block of several independent messages at once
+///
+/// Every message gets its own SIMD lane. The state is kept transposed: the eight state words are stored as
+/// eight rows, each row holding that word for all the lanes. None of the processing methods may be called
+/// unless the corresponding support check returns true.
+class Sha256MultiBuffer final {
+public:
+    /// Number of lanes of the AVX2 implementation
+    static constexpr Size AVX2_LANES = 8;
+
+    /// Number of lanes of the AVX-512 implementation
+    static constexpr Size AVX512_LANES = 16;
+
+    /// Returns true if the library was built with AVX2 support and the CPU supports it
+    static bool isAvx2Supported();
+
+    /// Compresses one 64 byte block into each of the 8 states
+    ///
+    /// \param state The transposed states, 8 rows of \ref AVX2_LANES words, updated in place
+    /// \param blocks One block per lane
+    static void processBlockAvx2(Dword* state, const Byte* const* blocks);
+
+    /// Returns true if the library was built with AVX-512 support and the CPU supports it
+    static bool isAvx512Supported();
+
+    /// Compresses one 64 byte block into each of the 16 states
+    ///
+    /// \param state The transposed states, 8 rows of \ref AVX512_LANES words, updated in place
+    /// \param blocks One block per lane
+    static void processBlockAvx512(Dword* state, const Byte* const* blocks);
+
+private:
+    Sha256MultiBuffer() = delete;
+};
+
+} // namespace crypto
+
+#endif // CPPLIBCRYPTO_HASH_SHA256MULTIBUFFER_H_
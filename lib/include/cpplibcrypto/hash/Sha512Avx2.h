@@ -0,0 +1,31 @@
+#ifndef CPPLIBCRYPTO_HASH_SHA512AVX2_H_
+#define CPPLIBCRYPTO_HASH_SHA512AVX2_H_
+
+#include "cpplibcrypto/common/common.h"
+
+namespace crypto {
+
+/// SHA-384/SHA-512 compression function with the message schedule computed using AVX2
+///
+/// The 80 message schedule words are computed four at a time, together with the round constants added to
+/// them, the rounds themselves are scalar. None of the methods but \ref isSupported() may be called unless
+/// \ref isSupported() returns true.
+class Sha512Avx2 final {
+public:
+    /// Returns true if the library was built with AVX2 support and the CPU supports it
+    static bool isSupported();
+
+    /// Compresses consecutive 128 byte blocks into the SHA-384/SHA-512 state
+    ///
+    /// \param state The eight state words H0..H7, updated in place
+    /// \param in The data, 128 * nBlocks bytes
+    /// \param nBlocks The number of blocks
+    static void processBlocks(Qword* state, const Byte* in, Size nBlocks);
+
+private:
+    Sha512Avx2() = delete;
+};
+
+} // namespace crypto
+
+#endif // CPPLIBCRYPTO_HASH_SHA512AVX2_H_
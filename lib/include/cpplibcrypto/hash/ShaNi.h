@@ -0,0 +1,36 @@
+#ifndef CPPLIBCRYPTO_HASH_SHANI_H_
+#define CPPLIBCRYPTO_HASH_SHANI_H_
+
+#include "cpplibcrypto/common/common.h"
+
+namespace crypto {
+
+/// SHA compression functions using the Intel SHA extensions
+///
+/// None of the methods but \ref isSupported() may be called unless \ref isSupported() returns true.
+class ShaNi final {
+public:
+    /// Returns true if the library was built with the SHA extensions support and the CPU supports them
+    static bool isSupported();
+
+    /// Compresses consecutive 64 byte blocks into the SHA-1 state
+    ///
+    /// \param state The five state words H0..H4, updated in place
+    /// \param in The data, 64 * nBlocks bytes
+    /// \param nBlocks The number of blocks
+    static void sha1ProcessBlocks(Dword* state, const Byte* in, Size nBlocks);
+
+    /// Compresses consecutive 64 byte blocks into the SHA-224/SHA-256 state
+    ///
+    /// \param state The eight state words H0..H7, updated in place
+    /// \param in The data, 64 * nBlocks bytes
+    /// \param nBlocks The number of blocks
+    static void sha256ProcessBlocks(Dword* state, const Byte* in, Size nBlocks);
+
+private:
+    ShaNi() = delete;
+};
+
+} // namespace crypto
+
+#endif // CPPLIBCRYPTO_HASH_SHANI_H_
@@ -0,0 +1,242 @@
+#ifndef CPPLIBCRYPTO_HASH_TREEHASH_H_
+#define CPPLIBCRYPTO_HASH_TREEHASH_H_
+
+#include "cpplibcrypto/buffer/BufferSlice.h"
+#include "cpplibcrypto/buffer/DynamicBuffer.h"
+#include "cpplibcrypto/common/Exception.h"
+#include "cpplibcrypto/common/Parallel.h"
+#include "cpplibcrypto/common/TypeTraits.h"
+#include "cpplibcrypto/common/common.h"
+#include "cpplibcrypto/io/Stream.h"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace crypto {
+
+/// Merkle tree hash over fixed-size leaves of the input
+///
+/// The input is split into leaves of the leaf size, the last one may be shorter. An empty input is a single
+/// empty leaf. The digests are
+///
+///     leaf = H(0x00 || leaf data)
+///     node = H(0x01 || left || right)
+///
+/// and the levels are combined pairwise up to the root, a node without a pair is moved to the next level
+/// as it is. The prefixes keep a leaf from being passed off as a node. The root depends on the leaf size,
+/// so it has to be the same for computing and verifying.
+///
+/// The leaves are independent, so they are hashed on several threads. The leaf digests are kept, see
+/// \ref getLeafDigests(). Stored along with the root, they allow verifying or locating a corrupted range
+/// by rehashing only the leaves it covers with \ref hashLeaf().
+///
+/// \tparam THash The hash algorithm, e.g. \ref Sha256 or \ref Sha1
+template <typename THash>
+class TreeHash final {
+public:
+    static constexpr Size DIGEST_SIZE = THash::DIGEST_SIZE;
+    static constexpr Size DEFAULT_LEAF_SIZE = 1024 * 1024;
+
+    /// \param leafSize The size of the leaves in bytes
+    explicit TreeHash(const Size leafSize = DEFAULT_LEAF_SIZE)
+        : mLeafSize(leafSize) {
+        ASSERT(leafSize > 0);
+    }
+
+    /// Sets the number of threads hashing the leaves, 1 by default, see parallel::resolveThreadCount()
+    void setThreadCount(const Size threadCount) { mThreadCount = threadCount; }
+
+    /// Updates the state with the given data
+    /// \throws Exception if \ref finalize() has already been called
+    template <typename TBuffer, typename = EnableIf<!std::is_base_of_v<InputStream, TBuffer>>>
+    void update(const TBuffer& in) {
+        static_assert(sizeof(*in.data()) == 1, "The input buffer elements must be bytes");
+        update(reinterpret_cast<const Byte*>(in.data()), in.size());
+    }
+
+    /// Updates the state with the given data
+    ///
+    /// Whole leaves are hashed straight from \p in, only the data of an incomplete batch of leaves is
+    /// buffered.
+    /// \throws Exception if \ref finalize() has already been called
+    void update(const Byte* in, Size size) {
+        checkNotFinalized();
+        const Size batchSize = getBatchLeaves() * mLeafSize;
+        while (size > 0) {
+            if (mPending.empty() && size >= mLeafSize) {
+                const Size leaves = std::min(size / mLeafSize, getBatchLeaves());
+                hashLeaves(in, leaves * mLeafSize);
+                in += leaves * mLeafSize;
+                size -= leaves * mLeafSize;
+                continue;
+            }
+            // The pending data may exceed the batch if the thread count has been lowered since it was added
+            const Size toCopy = std::min(size, batchSize - std::min(batchSize, mPending.size()));
+            mPending.insert(mPending.end(), in, in + toCopy);
+            in += toCopy;
+            size -= toCopy;
+            if (mPending.size() >= batchSize) {
+                hashPendingLeaves();
+            }
+        }
+    }
+
+    /// Updates the state with all the data remaining in the input
+    /// \throws Exception if \ref finalize() has already been called or thrown by the stream
+    void update(InputStream& input) {
+        checkNotFinalized();
+        const Size batchSize = getBatchLeaves() * mLeafSize;
+        for (bool eof = false; !eof;) {
+            if (mPending.size() >= batchSize) {
+                hashPendingLeaves();
+            }
+            const Size offset = mPending.size();
+            const Size toRead = batchSize - offset;
+            mPending.resize(batchSize);
+            const Size read = input.read(mPending.data() + offset, toRead);
+            mPending.resize(offset + read);
+            eof = read < toRead;
+        }
+    }
+
+    /// Finalizes the computation, outputs the root to the given buffer
+    /// \param out Output buffer where the root will be saved. Must be at least \ref DIGEST_SIZE long.
+    /// \throws Exception if \ref finalize() has already been called
+    template <typename TOut>
+    void finalize(TOut& out) {
+        checkNotFinalized();
+        if (!mPending.empty() || mLeafDigests.empty()) {
+            hashLeaves(mPending.data(), mPending.size());
+            mPending.clear();
+        }
+        computeRoot(mLeafDigests.data(), getLeafCount(), out);
+        mFinalized = true;
+    }
+
+    /// Resets the state, the leaf digests are discarded
+    void reset() {
+        mPending.clear();
+        mLeafDigests.clear();
+        mFinalized = false;
+    }
+
+    /// Returns the digests of the leaves hashed so far, DIGEST_SIZE bytes per leaf in the order of the leaves
+    ///
+    /// After \ref finalize(), these are the digests of all the leaves of the input.
+    const ByteBuffer& getLeafDigests() const { return mLeafDigests; }
+
+    /// Returns the number of leaves hashed so far
+    Size getLeafCount() const { return mLeafDigests.size() / DIGEST_SIZE; }
+
+    /// Returns the leaf size
+    Size getLeafSize() const { return mLeafSize; }
+
+    /// Computes the digest of a single leaf
+    /// \param leaf The data of the leaf
+    /// \param out Output for the digest, at least \ref DIGEST_SIZE bytes
+    template <typename TOut>
+    static void hashLeaf(BufferSlice<const Byte> leaf, TOut& out) {
+        hashNode(LEAF_PREFIX, leaf.data(), leaf.size(), nullptr, 0, out);
+    }
+
+    /// Combines the given leaf digests into the root
+    /// \param leafDigests The digests of the leaves, DIGEST_SIZE bytes per leaf
+    /// \param count The number of leaves, at least one
+    /// \param out Output for the root, at least \ref DIGEST_SIZE bytes
+    template <typename TOut>
+    static void computeRoot(const Byte* leafDigests, const Size count, TOut& out) {
+        ASSERT(count > 0);
+        ByteBuffer level;
+        level.insert(level.end(), leafDigests, leafDigests + count * DIGEST_SIZE);
+        for (Size nodes = count; nodes > 1; nodes = (nodes + 1) / 2) {
+            for (Size i = 0; i < nodes / 2; ++i) {
+                // The parents are written over the consumed part of the level
+                Byte* left = level.data() + 2 * i * DIGEST_SIZE;
+                Byte* parent = level.data() + i * DIGEST_SIZE;
+                hashNode(NODE_PREFIX, left, DIGEST_SIZE, left + DIGEST_SIZE, DIGEST_SIZE, parent);
+            }
+            if (nodes % 2 != 0) {
+                const Byte* last = level.data() + (nodes - 1) * DIGEST_SIZE;
+                std::copy(last, last + DIGEST_SIZE, level.data() + nodes / 2 * DIGEST_SIZE);
+            }
+        }
+        for (Size i = 0; i < DIGEST_SIZE; ++i) {
+            out[i] = level[i];
+        }
+    }
+
+private:
+    static constexpr Byte LEAF_PREFIX = 0x00;
+    static constexpr Byte NODE_PREFIX = 0x01;
+
+    /// The number of leaves hashed at once by each thread
+    static constexpr Size LEAVES_PER_THREAD = 4;
+
+    /// Computes H(prefix || first || second)
+    template <typename TOut>
+    static void hashNode(const Byte prefix,
+                         const Byte* first,
+                         const Size firstSize,
+                         const Byte* second,
+                         const Size secondSize,
+                         TOut& out) {
+        THash hasher;
+        hasher.update(&prefix, 1);
+        if (firstSize > 0) {
+            hasher.update(first, firstSize);
+        }
+        if (secondSize > 0) {
+            hasher.update(second, secondSize);
+        }
+        hasher.finalize(out);
+    }
+
+    /// Hashes the leaves of the given data, all of them full except possibly the last one. The threads write
+    /// the digests to disjoint parts of \ref mLeafDigests.
+    void hashLeaves(const Byte* data, const Size size) {
+        const Size count = std::max(Size(1), (size + mLeafSize - 1) / mLeafSize);
+        const Size first = mLeafDigests.size();
+        mLeafDigests.resize(first + count * DIGEST_SIZE);
+        Byte* digests = mLeafDigests.data() + first;
+        try {
+            parallel::forEach(count, mThreadCount, [&](const Size leaf) {
+                const Size offset = leaf * mLeafSize;
+                Byte* digest = digests + leaf * DIGEST_SIZE;
+                hashNode(LEAF_PREFIX, data + offset, std::min(mLeafSize, size - offset), nullptr, 0, digest);
+            });
+        } catch (...) {
+            mLeafDigests.resize(first);
+            throw;
+        }
+    }
+
+    /// Hashes the whole leaves of \ref mPending, keeping the partial leaf at its end
+    void hashPendingLeaves() {
+        const Size whole = mPending.size() / mLeafSize * mLeafSize;
+        if (whole == 0) {
+            return;
+        }
+        hashLeaves(mPending.data(), whole);
+        std::copy(mPending.data() + whole, mPending.data() + mPending.size(), mPending.data());
+        mPending.resize(mPending.size() - whole);
+    }
+
+    void checkNotFinalized() const {
+        if (mFinalized) {
+            throw Exception(
+                "TreeHash: The root already has been computed. Reset the state to compute another root.");
+        }
+    }
+
+    Size getBatchLeaves() const { return parallel::resolveThreadCount(mThreadCount) * LEAVES_PER_THREAD; }
+
+    Size mLeafSize;
+    Size mThreadCount = 1;
+    ByteBuffer mPending;
+    ByteBuffer mLeafDigests;
+    bool mFinalized = false;
+};
+
+} // namespace crypto
+
+#endif // CPPLIBCRYPTO_HASH_TREEHASH_H_
@@ -0,0 +1,179 @@
+#ifndef CPPLIBCRYPTO_IO_ASYNCFILESTREAM_H_
+#define CPPLIBCRYPTO_IO_ASYNCFILESTREAM_H_
+
+#include "cpplibcrypto/buffer/BufferSlice.h"
+#include "cpplibcrypto/buffer/String.h"
+#include "cpplibcrypto/common/common.h"
+#include "cpplibcrypto/io/Stream.h"
+
+#include <memory>
+
+namespace crypto {
+
+class IoUring;
+
+/// Buffering of the asynchronous file streams
+struct AsyncFileOptions {
+    /// The number of buffers, which is also the maximum number of requests in flight
+    Size bufferCount = 4;
+
+    /// The size of one buffer, rounded up to the page size
+    Size bufferSize = 256 * 1024;
+
+    /// Bypasses the page cache (O_DIRECT)
+    ///
+    /// Only a hint, if the file system doesn't support direct I/O the file is accessed through the page
+    /// cache.
+    bool direct = false;
+};
+
+/// Input stream reading ahead of the consumer using io_uring (Linux 5.6+)
+///
+/// The file is read into a ring of page-aligned buffers registered with the kernel. All the buffers are
+/// queued for reading right away, and a buffer is queued again for the next unread part of the file as soon
+/// as the consumer is done with it. While the data of one buffer is being hashed or encrypted, the following
+/// ones are being read in the background.
+///
+/// \ref next() gives the data of the buffers without copying, \ref read() copies it like
+/// \ref FileInputStream does. The size of the file is taken when it is opened, data appended later is not
+/// read.
+class AsyncFileInputStream : public InputStream {
+public:
+    /// Returns true if the kernel supports io_uring and it is not disabled
+    static bool isSupported();
+
+    /// Opens the given file and starts reading it
+    /// \throws Exception in case the file couldn't be open, it is not a regular file or io_uring is not
+    /// supported
+    explicit AsyncFileInputStream(String fileName, const AsyncFileOptions& options = AsyncFileOptions());
+
+    ~AsyncFileInputStream() noexcept override;
+
+    /// \throws Exception in case the data couldn't be read
+    Size read(void* output, const Size count) override;
+
+    /// Returns the unconsumed data of the current buffer and moves past it
+    ///
+    /// The window stays valid until the next call to \ref next(), \ref read() or \ref close(). At EOF, an
+    /// empty window is returned.
+    /// \throws Exception in case the data couldn't be read
+    BufferSlice<const Byte> next();
+
+    bool eof() const override;
+
+    /// Waits for the reads in flight and closes the file
+    void close() override;
+
+    /// Returns whether or not the file is open
+    bool isOpen() const { return mFd >= 0; }
+
+    /// Returns true if the file is read bypassing the page cache
+    bool isDirect() const { return mDirect; }
+
+    /// Returns the size of the file at the time it was opened
+    Size getSize() const { return mFileSize; }
+
+private:
+    enum class SlotState { IDLE, PENDING, READY };
+
+    struct Slot {
+        SlotState state = SlotState::IDLE;
+        Size offset = 0;
+        Size expected = 0;
+        Size filled = 0;
+    };
+
+    /// Queues the read of the next unread part of the file into the given slot
+    void requestNext(Size slot);
+
+    /// Waits until the head slot is ready, moves to the next slot first if the head one has been consumed
+    void advance();
+
+    void waitForCompletion();
+
+    String mFileName;
+    int mFd = -1;
+    bool mDirect = false;
+    std::unique_ptr<IoUring> mRing;
+    std::unique_ptr<Slot[]> mSlots;
+    Size mSlotCount = 0;
+    Size mFileSize = 0;
+    Size mNextOffset = 0;
+    Size mPosition = 0;
+    Size mHead = 0;
+    Size mHeadConsumed = 0;
+};
+
+/// Output stream writing in the background using io_uring (Linux 5.6+)
+///
+/// The data is collected in a ring of page-aligned buffers registered with the kernel. A full buffer is
+/// queued for writing and the stream continues with the next one, it only has to wait when all of them are
+/// in flight. This way, encrypting the next part of the data overlaps with writing the previous one.
+///
+/// With direct I/O, the writes have to be aligned to the block size. \ref flush() then only writes out the
+/// full buffers, the last partial one is written on \ref close(), padded and truncated back to the size.
+class AsyncFileOutputStream : public OutputStream {
+public:
+    enum class OpenMode { OVERWRITE, APPEND };
+
+    /// Returns true if the kernel supports io_uring and it is not disabled
+    static bool isSupported() { return AsyncFileInputStream::isSupported(); }
+
+    /// Opens the given file in the given mode
+    /// \throws Exception in case the file couldn't be open or io_uring is not supported
+    explicit AsyncFileOutputStream(String fileName,
+                                   const OpenMode mode = OpenMode::OVERWRITE,
+                                   const AsyncFileOptions& options = AsyncFileOptions());
+
+    ~AsyncFileOutputStream() noexcept override;
+
+    /// Copies the data into the buffers, queueing the full ones for writing
+    /// \throws Exception in case one of the previous writes failed
+    void write(const void* source, const Size count) override;
+
+    /// Writes out the buffered data and waits for all the writes to complete
+    /// \throws Exception in case any of the writes failed
+    void flush() override;
+
+    /// Flushes the stream and closes the file
+    /// \throws Exception in case any of the writes failed
+    void close() override;
+
+    /// Returns whether or not the file is open
+    bool isOpen() const { return mFd >= 0; }
+
+    /// Returns true if the file is written bypassing the page cache
+    bool isDirect() const { return mDirect; }
+
+private:
+    enum class SlotState { FILLING, PENDING };
+
+    struct Slot {
+        SlotState state = SlotState::FILLING;
+        Size offset = 0;
+        Size size = 0;
+        Size written = 0;
+    };
+
+    /// Queues the write of the current slot and moves to the next one
+    void submitCurrent();
+
+    /// Queues the write of the rest of the given slot
+    void requestWrite(Size slot);
+
+    void waitForCompletion();
+
+    String mFileName;
+    int mFd = -1;
+    bool mDirect = false;
+    std::unique_ptr<IoUring> mRing;
+    std::unique_ptr<Slot[]> mSlots;
+    Size mSlotCount = 0;
+    Size mCurrent = 0;
+    Size mPending = 0;
+    Size mOffset = 0;
+};
+
+} // namespace crypto
+
+#endif // CPPLIBCRYPTO_IO_ASYNCFILESTREAM_H_
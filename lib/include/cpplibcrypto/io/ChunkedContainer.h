@@ -0,0 +1,414 @@
+#ifndef CPPLIBCRYPTO_IO_CHUNKEDCONTAINER_H_
+#define CPPLIBCRYPTO_IO_CHUNKEDCONTAINER_H_
+
+#include "cpplibcrypto/buffer/BufferSlice.h"
+#include "cpplibcrypto/buffer/DynamicBuffer.h"
+#include "cpplibcrypto/cipher/Aes.h"
+#include "cpplibcrypto/buffer/utils/bufferUtils.h"
+#include "cpplibcrypto/common/Exception.h"
+#include "cpplibcrypto/common/Memory.h"
+#include "cpplibcrypto/common/Parallel.h"
+#include "cpplibcrypto/common/bitManip.h"
+#include "cpplibcrypto/common/common.h"
+#include "cpplibcrypto/hash/Hmac.h"
+#include "cpplibcrypto/hash/Sha2.h"
+#include "cpplibcrypto/io/Stream.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+
+namespace crypto {
+
+/// Encrypted container made of independently encrypted and authenticated chunks
+///
+/// Unlike a single CBC chain, every chunk can be encrypted, verified and decrypted on its own. Both
+/// directions spread the chunks across several cores and a reader can decrypt any byte range by touching
+/// only the chunks it covers. The format is:
+///
+///     header  = magic "CPCC" || version (1) || reserved (3 zero bytes) || chunk size (u32 BE) || nonce (8)
+///     chunk i = AES-CTR(ciphertext) || tag (32)
+///     tag     = HMAC-SHA256(header || i (u64 BE) || last (1) || ciphertext)
+///
+/// Chunk i is encrypted with the counter block nonce || i (u32 BE) || 0 (u32), so the keystreams of the
+/// chunks never overlap. All chunks have the chunk size except the last one, which is always shorter, even
+/// empty if the data is a multiple of the chunk size. Since the tags cover the header, the position of the
+/// chunk and whether it is the last one, chunks can't be reordered, swapped between containers, dropped or
+/// cut off without the decoder noticing.
+///
+/// The nonce must never repeat for the same key, and the AES and HMAC keys must be independent.
+class ChunkedContainer {
+public:
+    static constexpr Size HEADER_SIZE = 20;
+    static constexpr Size NONCE_SIZE = 8;
+    static constexpr Size TAG_SIZE = Hmac<Sha256>::DIGEST_SIZE;
+    static constexpr Size DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+    /// The largest chunk size the decoder accepts, bounds the memory allocated for an untrusted header
+    static constexpr Size MAX_CHUNK_SIZE = 16 * 1024 * 1024;
+
+    /// Sets the number of threads processing the chunks, 1 by default, see parallel::resolveThreadCount()
+    void setThreadCount(const Size threadCount) { mThreadCount = threadCount; }
+
+    /// Returns the size of the data held by the given container
+    /// \throws Exception in case the header is invalid or the container is truncated
+    static Qword getPlaintextSize(BufferSlice<const Byte> container) {
+        const Size chunkSize = parseHeader(container.data(), container.size());
+        return getLayout(chunkSize, container.size() - HEADER_SIZE).plaintextSize;
+    }
+
+protected:
+    static constexpr Byte MAGIC[4] = { 'C', 'P', 'C', 'C' };
+    static constexpr Byte VERSION = 1;
+
+    /// The number of chunks read or written at once by each thread
+    static constexpr Size CHUNKS_PER_THREAD = 16;
+
+    static constexpr Size AES_BLOCK_SIZE = 16;
+
+    /// The number of keystream blocks generated by one call to the cipher
+    static constexpr Size CTR_RUN_BLOCKS = 8;
+
+    /// Per-thread state of the workers
+    struct Worker {
+        Sha256 hasher;
+    };
+
+    /// Sizes of a complete container
+    struct Layout {
+        Qword chunkCount;
+        Size lastChunkSize;
+        Qword plaintextSize;
+    };
+
+    ChunkedContainer(const AesKey& key, const HmacKey& macKey)
+        : mCipher(key)
+        , mHmac(macKey) {}
+
+    /// Writes the header into \p out, HEADER_SIZE bytes
+    static void writeHeader(Byte* out, const Size chunkSize, const Byte* nonce) {
+        std::copy(MAGIC, MAGIC + sizeof(MAGIC), out);
+        out[4] = VERSION;
+        std::fill(out + 5, out + 8, Byte(0));
+        bits::storeBigEndian(out + 8, Dword(chunkSize));
+        std::copy(nonce, nonce + NONCE_SIZE, out + 12);
+    }
+
+    /// Validates the header at the beginning of \p data
+    /// \returns The chunk size
+    /// \throws Exception in case the header is invalid or incomplete
+    static Size parseHeader(const Byte* data, const Size size) {
+        if (size < HEADER_SIZE) {
+            throw Exception("Chunked container: Truncated header");
+        }
+        if (!std::equal(MAGIC, MAGIC + sizeof(MAGIC), data)) {
+            throw Exception("Chunked container: Invalid magic");
+        }
+        if (data[4] != VERSION) {
+            throw Exception("Chunked container: Unsupported version");
+        }
+        if (data[5] != 0 || data[6] != 0 || data[7] != 0) {
+            throw Exception("Chunked container: Invalid header");
+        }
+        const Size chunkSize = bits::loadBigEndian<Dword>(data + 8);
+        if (chunkSize == 0 || chunkSize > MAX_CHUNK_SIZE) {
+            throw Exception("Chunked container: Invalid chunk size");
+        }
+        return chunkSize;
+    }
+
+    /// Computes the sizes of a container whose chunks take \p bodySize bytes
+    /// \throws Exception in case the last chunk is missing or cut off
+    static Layout getLayout(const Size chunkSize, const Size bodySize) {
+        const Size recordSize = chunkSize + TAG_SIZE;
+        const Size rest = bodySize % recordSize;
+        if (rest < TAG_SIZE) {
+            throw Exception("Chunked container: Truncated data");
+        }
+        const Qword fullChunks = bodySize / recordSize;
+        return Layout{ fullChunks + 1, rest - TAG_SIZE, fullChunks * chunkSize + rest - TAG_SIZE };
+    }
+
+    static void checkChunkIndex(const Qword index) {
+        if (index > std::numeric_limits<Dword>::max()) {
+            throw Exception("Chunked container: Too many chunks");
+        }
+    }
+
+    /// Encrypts or decrypts \p size bytes of the given chunk, starting at \p offset within the chunk
+    ///
+    /// The keystream is generated on the stack a run of blocks at a time and XORed straight into \p out.
+    /// A chunk has less than 2^32 blocks, so the block number never carries out of the low Dword of the
+    /// counter block.
+    void crypt(const Byte* header,
+               const Qword index,
+               const Size offset,
+               const Byte* in,
+               const Size size,
+               Byte* out) const {
+        Byte keystream[CTR_RUN_BLOCKS * AES_BLOCK_SIZE];
+        Dword block = Dword(offset / AES_BLOCK_SIZE);
+        Size skip = offset % AES_BLOCK_SIZE;
+        for (Size done = 0; done < size;) {
+            const Size needed = (skip + size - done + AES_BLOCK_SIZE - 1) / AES_BLOCK_SIZE;
+            const Size blocks = std::min(CTR_RUN_BLOCKS, needed);
+            for (Size i = 0; i < blocks; ++i) {
+                Byte* counter = keystream + i * AES_BLOCK_SIZE;
+                std::copy(header + 12, header + 12 + NONCE_SIZE, counter);
+                bits::storeBigEndian(counter + NONCE_SIZE, Dword(index));
+                bits::storeBigEndian(counter + NONCE_SIZE + 4, Dword(block + i));
+            }
+            mCipher.encryptBlocks(keystream, keystream, blocks);
+            const Size toProcess = std::min(blocks * AES_BLOCK_SIZE - skip, size - done);
+            bufferUtils::xorBytes(out + done, in + done, keystream + skip, toProcess);
+            done += toProcess;
+            block += Dword(blocks);
+            skip = 0;
+        }
+        memory::wipe(keystream, sizeof(keystream));
+    }
+
+    /// Computes the tag of the given chunk ciphertext into \p tag, TAG_SIZE bytes
+    void computeTag(const Byte* header,
+                    const Qword index,
+                    const bool last,
+                    const Byte* ciphertext,
+                    const Size size,
+                    Byte* tag,
+                    Worker& worker) const {
+        Byte position[9];
+        bits::storeBigEndian(position, index);
+        position[8] = last ? 1 : 0;
+
+        // HMAC from the precomputed pad states, see Pbkdf2Core
+        Sha256& hasher = worker.hasher;
+        hasher.setState(mHmac.getInnerState(), Sha256::BLOCK_SIZE);
+        hasher.update(header, HEADER_SIZE);
+        hasher.update(position, sizeof(position));
+        hasher.update(ciphertext, size);
+        Byte digest[Sha256::DIGEST_SIZE];
+        hasher.finalize(digest);
+
+        hasher.setState(mHmac.getOuterState(), Sha256::BLOCK_SIZE);
+        hasher.update(digest, sizeof(digest));
+        hasher.finalize(tag);
+    }
+
+    /// Verifies the tag of the given chunk in constant time
+    bool verifyTag(const Byte* header,
+                   const Qword index,
+                   const bool last,
+                   const Byte* ciphertext,
+                   const Size size,
+                   const Byte* tag,
+                   Worker& worker) const {
+        Byte expected[TAG_SIZE];
+        computeTag(header, index, last, ciphertext, size, expected, worker);
+        Byte difference = 0;
+        for (Size i = 0; i < TAG_SIZE; ++i) {
+            difference |= expected[i] ^ tag[i];
+        }
+        return difference == 0;
+    }
+
+    Aes mCipher;
+    Hmac<Sha256> mHmac;
+    Size mThreadCount = 1;
+};
+
+/// Writes data from an \ref InputStream into a \ref ChunkedContainer
+///
+///     ChunkedEncoder encoder(key, macKey, nonce);
+///     encoder.setThreadCount(0);
+///     encoder.encode(input, output);
+class ChunkedEncoder final : public ChunkedContainer {
+public:
+    /// \param key The AES key encrypting the chunks
+    /// \param macKey The HMAC key authenticating the chunks, independent of \p key
+    /// \param nonce NONCE_SIZE bytes, unique for every container encrypted with \p key
+    /// \param chunkSize The size of the plaintext of a chunk
+    /// \throws Exception in case the nonce or the chunk size is invalid
+    ChunkedEncoder(const AesKey& key,
+                   const HmacKey& macKey,
+                   BufferSlice<const Byte> nonce,
+                   const Size chunkSize = DEFAULT_CHUNK_SIZE)
+        : ChunkedContainer(key, macKey)
+        , mChunkSize(chunkSize) {
+        if (nonce.size() != NONCE_SIZE) {
+            throw Exception("Chunked container: Invalid nonce size");
+        }
+        if (chunkSize == 0 || chunkSize > MAX_CHUNK_SIZE) {
+            throw Exception("Chunked container: Invalid chunk size");
+        }
+        writeHeader(mHeader, chunkSize, nonce.data());
+    }
+
+    /// Encrypts the whole input into a container written to the output
+    /// \returns The number of bytes written to the output
+    /// \throws Exception in case the input is too large for the chunk size or thrown by the streams
+    Qword encode(InputStream& input, OutputStream& output) {
+        const Size recordSize = mChunkSize + TAG_SIZE;
+        const Size batchChunks = parallel::resolveThreadCount(mThreadCount) * CHUNKS_PER_THREAD;
+        DynamicBuffer<Byte> plaintext(batchChunks * mChunkSize);
+        plaintext.setSensitive();
+        ByteBuffer ciphertext(batchChunks * recordSize);
+
+        output.write(mHeader, HEADER_SIZE);
+        Qword written = HEADER_SIZE;
+        Qword firstChunk = 0;
+        for (bool last = false; !last;) {
+            // A short read means EOF, the partial (or empty) chunk following the full ones is the last one
+            const Size read = input.read(plaintext.data(), plaintext.size());
+            last = read < plaintext.size();
+            const Size chunkCount = last ? read / mChunkSize + 1 : batchChunks;
+            checkChunkIndex(firstChunk + chunkCount - 1);
+
+            parallel::forEachWithState<Worker>(chunkCount, mThreadCount, [&](const Size i, Worker& worker) {
+                const bool isLast = last && i == chunkCount - 1;
+                const Size size = isLast ? read % mChunkSize : mChunkSize;
+                Byte* record = ciphertext.data() + i * recordSize;
+                crypt(mHeader, firstChunk + i, 0, plaintext.data() + i * mChunkSize, size, record);
+                computeTag(mHeader, firstChunk + i, isLast, record, size, record + size, worker);
+            });
+
+            const Size batchSize = read + chunkCount * TAG_SIZE;
+            output.write(ciphertext.data(), batchSize);
+            written += batchSize;
+            firstChunk += chunkCount;
+        }
+        output.flush();
+        return written;
+    }
+
+private:
+    Byte mHeader[HEADER_SIZE];
+    Size mChunkSize;
+};
+
+/// Reads data from a \ref ChunkedContainer
+///
+/// \ref decode() decrypts a whole container from a stream. \ref decodeRange() decrypts a byte range of a
+/// container held in memory, e.g. mapped by \ref MappedFileInputStream, verifying and decrypting only the
+/// chunks the range covers.
+///
+/// Plaintext is only ever output after its chunk has been verified.
+class ChunkedDecoder final : public ChunkedContainer {
+public:
+    /// \param key The AES key the chunks were encrypted with
+    /// \param macKey The HMAC key the chunks were authenticated with
+    ChunkedDecoder(const AesKey& key, const HmacKey& macKey)
+        : ChunkedContainer(key, macKey) {}
+
+    /// Verifies and decrypts the whole container read from the input
+    ///
+    /// The chunks are verified in batches before the batch is written. On failure, the output holds the
+    /// verified data preceding the failing batch, the caller should discard it.
+    /// \returns The number of bytes written to the output
+    /// \throws Exception in case the container is invalid, truncated or fails authentication, or thrown by
+    /// the streams
+    Qword decode(InputStream& input, OutputStream& output) {
+        Byte header[HEADER_SIZE];
+        const Size chunkSize = parseHeader(header, input.read(header, HEADER_SIZE));
+        const Size recordSize = chunkSize + TAG_SIZE;
+        const Size batchChunks = parallel::resolveThreadCount(mThreadCount) * CHUNKS_PER_THREAD;
+        ByteBuffer ciphertext(batchChunks * recordSize);
+        DynamicBuffer<Byte> plaintext(batchChunks * chunkSize);
+        plaintext.setSensitive();
+
+        Qword written = 0;
+        Qword firstChunk = 0;
+        for (bool last = false; !last;) {
+            // The last chunk is always shorter than the others, a full batch can't contain it
+            const Size read = input.read(ciphertext.data(), ciphertext.size());
+            last = read < ciphertext.size();
+            Size chunkCount = batchChunks;
+            Size lastChunkSize = chunkSize;
+            if (last) {
+                const Layout layout = getLayout(chunkSize, read);
+                chunkCount = Size(layout.chunkCount);
+                lastChunkSize = layout.lastChunkSize;
+            }
+            checkChunkIndex(firstChunk + chunkCount - 1);
+
+            std::atomic<bool> authentic(true);
+            parallel::forEachWithState<Worker>(chunkCount, mThreadCount, [&](const Size i, Worker& worker) {
+                const bool isLast = last && i == chunkCount - 1;
+                const Size size = isLast ? lastChunkSize : chunkSize;
+                const Byte* record = ciphertext.data() + i * recordSize;
+                if (!verifyTag(header, firstChunk + i, isLast, record, size, record + size, worker)) {
+                    authentic = false;
+                    return;
+                }
+                crypt(header, firstChunk + i, 0, record, size, plaintext.data() + i * chunkSize);
+            });
+            if (!authentic) {
+                throw Exception("Chunked container: Authentication failed");
+            }
+
+            const Size batchSize = (chunkCount - 1) * chunkSize + lastChunkSize;
+            output.write(plaintext.data(), batchSize);
+            written += batchSize;
+            firstChunk += chunkCount;
+        }
+        output.flush();
+        return written;
+    }
+
+    /// Verifies and decrypts the given byte range of the data held by the container
+    /// \param container The whole container
+    /// \param offset The offset of the range within the plaintext
+    /// \param size The size of the range
+    /// \param out The buffer the plaintext is appended to
+    /// \throws Exception in case the container is invalid or truncated, the range is out of bounds or any
+    /// of the chunks it covers fails authentication. Nothing is appended to \p out then.
+    void decodeRange(BufferSlice<const Byte> container,
+                     const Qword offset,
+                     const Size size,
+                     ByteBuffer& out) {
+        const Byte* header = container.data();
+        const Size chunkSize = parseHeader(header, container.size());
+        const Layout layout = getLayout(chunkSize, container.size() - HEADER_SIZE);
+        if (offset > layout.plaintextSize || size > layout.plaintextSize - offset) {
+            throw Exception("Chunked container: Range out of bounds");
+        }
+        if (size == 0) {
+            return;
+        }
+
+        const Qword end = offset + size;
+        const Qword firstChunk = offset / chunkSize;
+        const Qword lastChunk = (end - 1) / chunkSize;
+        const Byte* body = header + HEADER_SIZE;
+        const Size start = out.size();
+        out.resize(start + size);
+
+        const Size chunkCount = Size(lastChunk - firstChunk + 1);
+        std::atomic<bool> authentic(true);
+        parallel::forEachWithState<Worker>(chunkCount, mThreadCount, [&](const Size i, Worker& worker) {
+            const Qword index = firstChunk + i;
+            const bool isLast = index == layout.chunkCount - 1;
+            const Size chunkLength = isLast ? layout.lastChunkSize : chunkSize;
+            const Byte* record = body + index * (chunkSize + TAG_SIZE);
+            if (!verifyTag(header, index, isLast, record, chunkLength, record + chunkLength, worker)) {
+                authentic = false;
+                return;
+            }
+            // Only the part of the chunk inside the range is decrypted
+            const Qword chunkStart = index * chunkSize;
+            const Qword from = std::max(offset, chunkStart);
+            const Qword to = std::min(end, chunkStart + chunkLength);
+            crypt(header, index, Size(from - chunkStart), record + (from - chunkStart), Size(to - from),
+                  out.data() + start + (from - offset));
+        });
+        if (!authentic) {
+            std::fill(out.data() + start, out.data() + out.size(), Byte(0));
+            out.resize(start);
+            throw Exception("Chunked container: Authentication failed");
+        }
+    }
+};
+
+} // namespace crypto
+
+#endif // CPPLIBCRYPTO_IO_CHUNKEDCONTAINER_H_
@@ -0,0 +1,211 @@
+#ifndef CPPLIBCRYPTO_IO_FILEPIPELINE_H_
+#define CPPLIBCRYPTO_IO_FILEPIPELINE_H_
+
+#include "cpplibcrypto/buffer/BufferSlice.h"
+#include "cpplibcrypto/buffer/DynamicBuffer.h"
+#include "cpplibcrypto/common/Exception.h"
+#include "cpplibcrypto/common/SpscQueue.h"
+#include "cpplibcrypto/common/TypeTraits.h"
+#include "cpplibcrypto/common/common.h"
+#include "cpplibcrypto/io/Stream.h"
+#include "cpplibcrypto/padding/Padding.h"
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+namespace crypto {
+
+/// Streams data from an input through a cipher mode to an output, with the three stages on separate threads
+///
+/// The reader thread fills buffers from the \ref InputStream, the calling thread runs them through the cipher
+/// and the writer thread writes the results to the \ref OutputStream. The stages pass the buffers through
+/// bounded \ref SpscQueue "lock-free queues" and return them for reuse, so there is no allocation once the
+/// pipeline is running. The throughput is given by the slowest stage instead of the sum of all three.
+///
+/// Works with any mode object having `Size update(BufferSlice<const Byte>, ByteBuffer&)`, i.e. the
+/// `Encryption` and `Decryption` parts of \ref CbcMode, \ref CtrMode or \ref GcmMode. The mode is only
+/// touched by the calling thread.
+///
+/// The output is written as the data goes, before the `finish` callback of \ref run(). With
+/// `GcmMode::Decryption`, the plaintext reaches the output before the tag is verified in `finish`. If
+/// \ref run() throws, the output has to be discarded, it may hold unauthenticated plaintext.
+///
+///     CbcMode<Aes>::Encryption encryptor(key, iv);
+///     FileInputStream input(plainFile);
+///     FileOutputStream output(cipherFile);
+///     FilePipeline().run(input, encryptor, output, Pkcs7());
+class FilePipeline final {
+public:
+    /// Constructs the pipeline
+    /// \param bufferSize The size of the buffers read from the input
+    /// \param bufferCount The number of buffers each stage can be ahead of the following one
+    explicit FilePipeline(const Size bufferSize = 1 << 20, const Size bufferCount = 4)
+        : mBufferSize(bufferSize)
+        , mBufferCount(bufferCount) {
+        ASSERT(bufferSize > 0 && bufferCount > 0);
+    }
+
+    /// Processes the whole input, then lets \p finish append the final data, e.g. the padding
+    /// \param finish Called as `finish(ByteBuffer& out)` after the last update, on the calling thread
+    /// \returns The number of bytes written to the output
+    /// \throws Exception thrown by any of the stages, the other stages are stopped
+    template <typename TMode,
+              typename TFinish,
+              typename = EnableIf<std::is_invocable_v<TFinish&, ByteBuffer&>>>
+    Size run(InputStream& input, TMode& mode, OutputStream& output, TFinish finish) {
+        return process(input, output, [&mode, &finish](Chunk& in, Chunk& out) {
+            mode.update(BufferSlice<const Byte>(in.data.data(), in.data.data() + in.size), out.data);
+            if (in.last) {
+                finish(out.data);
+            }
+        });
+    }
+
+    /// Processes the whole input and finalizes the mode with the given padding, see \ref CbcMode
+    /// \returns The number of bytes written to the output
+    /// \throws Exception thrown by any of the stages, the other stages are stopped
+    template <typename TMode>
+    Size run(InputStream& input, TMode& mode, OutputStream& output, const Padding& padding) {
+        return run(input, mode, output, [&mode, &padding](ByteBuffer& out) { mode.finalize(out, padding); });
+    }
+
+    /// Processes the whole input with a mode which needs no finalization, like \ref CtrMode
+    /// \returns The number of bytes written to the output
+    /// \throws Exception thrown by any of the stages, the other stages are stopped
+    template <typename TMode>
+    Size run(InputStream& input, TMode& mode, OutputStream& output) {
+        return run(input, mode, output, [](ByteBuffer&) {});
+    }
+
+private:
+    struct Chunk {
+        ByteBuffer data;
+        Size size = 0;
+        bool last = false;
+    };
+
+    using Queue = SpscQueue<Chunk*>;
+
+    /// Thrown inside a stage to unwind it when another stage has failed
+    struct Stopped {};
+
+    template <typename TTransform>
+    Size process(InputStream& input, OutputStream& output, TTransform transform) {
+        std::unique_ptr<Chunk[]> inputChunks(new Chunk[mBufferCount]);
+        std::unique_ptr<Chunk[]> outputChunks(new Chunk[mBufferCount]);
+        Queue freeInput(mBufferCount);
+        Queue filled(mBufferCount);
+        Queue freeOutput(mBufferCount);
+        Queue processed(mBufferCount);
+        for (Size i = 0; i < mBufferCount; ++i) {
+            inputChunks[i].data.resize(mBufferSize);
+            // Room for the blocks held back from the previous buffer and the padding
+            outputChunks[i].data.reserve(mBufferSize + 64);
+            freeInput.tryPush(&inputChunks[i]);
+            freeOutput.tryPush(&outputChunks[i]);
+        }
+
+        std::atomic<bool> stop{ false };
+        std::exception_ptr readerError;
+        std::exception_ptr writerError;
+        Size written = 0;
+
+        std::thread reader([&] {
+            runStage(stop, readerError, [&] {
+                for (bool last = false; !last;) {
+                    Chunk* chunk = pop(freeInput, stop);
+                    chunk->size = input.read(chunk->data.data(), mBufferSize);
+                    last = chunk->size < mBufferSize || input.eof();
+                    chunk->last = last;
+                    push(filled, chunk, stop);
+                }
+            });
+        });
+        std::thread writer([&] {
+            runStage(stop, writerError, [&] {
+                for (bool last = false; !last;) {
+                    Chunk* chunk = pop(processed, stop);
+                    output.write(chunk->data.data(), chunk->data.size());
+                    written += chunk->data.size();
+                    last = chunk->last;
+                    push(freeOutput, chunk, stop);
+                }
+                output.flush();
+            });
+        });
+
+        std::exception_ptr error;
+        runStage(stop, error, [&] {
+            for (bool last = false; !last;) {
+                Chunk* in = pop(filled, stop);
+                Chunk* out = pop(freeOutput, stop);
+                out->data.clear();
+                transform(*in, *out);
+                last = out->last = in->last;
+                push(freeInput, in, stop);
+                push(processed, out, stop);
+            }
+        });
+        reader.join();
+        writer.join();
+
+        for (const std::exception_ptr& e : { error, readerError, writerError }) {
+            if (e) {
+                std::rethrow_exception(e);
+            }
+        }
+        return written;
+    }
+
+    /// Runs the stage, on failure records the exception and stops the other stages
+    template <typename TStage>
+    static void runStage(std::atomic<bool>& stop, std::exception_ptr& error, TStage stage) {
+        try {
+            stage();
+        } catch (const Stopped&) {
+        } catch (...) {
+            error = std::current_exception();
+            stop = true;
+        }
+    }
+
+    static Chunk* pop(Queue& queue, const std::atomic<bool>& stop) {
+        Chunk* chunk = nullptr;
+        for (Size attempt = 0; !queue.tryPop(chunk); ++attempt) {
+            backOff(attempt, stop);
+        }
+        return chunk;
+    }
+
+    static void push(Queue& queue, Chunk* chunk, const std::atomic<bool>& stop) {
+        for (Size attempt = 0; !queue.tryPush(chunk); ++attempt) {
+            backOff(attempt, stop);
+        }
+    }
+
+    /// Spins for a while, then yields, then sleeps, so a stage waiting for a slow disk doesn't burn a core
+    static void backOff(const Size attempt, const std::atomic<bool>& stop) {
+        if (stop.load(std::memory_order_relaxed)) {
+            throw Stopped();
+        }
+        if (attempt < 64) {
+            return;
+        }
+        if (attempt < 1024) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+
+    Size mBufferSize;
+    Size mBufferCount;
+};
+
+} // namespace crypto
+
+#endif // CPPLIBCRYPTO_IO_FILEPIPELINE_H_
@@ -0,0 +1,160 @@
+#ifndef CPPLIBCRYPTO_IO_MAPPEDFILEINPUTSTREAM_H_
+#define CPPLIBCRYPTO_IO_MAPPEDFILEINPUTSTREAM_H_
+
+#include "cpplibcrypto/buffer/BufferSlice.h"
+#include "cpplibcrypto/buffer/String.h"
+#include "cpplibcrypto/common/Exception.h"
+#include "cpplibcrypto/io/Stream.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace crypto {
+
+/// Input stream reading a file through a read-only memory mapping
+///
+/// Unlike \ref FileInputStream, the data doesn't have to be copied out of the page cache. \ref next() returns
+/// a window into the mapping which can be passed straight to a hash or a cipher, e.g.
+///
+///     MappedFileInputStream input(fileName);
+///     while (!input.eof()) {
+///         sha.update(input.next(MappedFileInputStream::DEFAULT_WINDOW_SIZE));
+///     }
+///
+/// The kernel is told the file will be read sequentially, and every window asks it to read ahead the one
+/// following it. \ref read() is still available for code working with any \ref InputStream, it copies the
+/// data like \ref FileInputStream does.
+///
+/// The windows stay valid until the stream is closed or destroyed. The file must not be truncated while it
+/// is mapped, accessing the pages past the new end raises SIGBUS.
+class MappedFileInputStream : public InputStream {
+public:
+    /// The window size large enough for the readahead to keep up with the hashes and ciphers
+    static constexpr Size DEFAULT_WINDOW_SIZE = 1 << 20;
+
+    ~MappedFileInputStream() noexcept { closeImpl(); }
+
+    /// Maps the given file for reading
+    /// \throws Exception in case the file couldn't be open or mapped, or it is not a regular file
+    explicit MappedFileInputStream(const String& fileName) {
+        const int fd = ::open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw Exception("Could not open the file specified (" + fileName + ')');
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw Exception("Could not get the size of the file specified (" + fileName + ')');
+        }
+        // Pipes, devices and /proc files report a size of 0 and would silently read as empty
+        if (!S_ISREG(info.st_mode)) {
+            ::close(fd);
+            throw Exception("The file specified is not a regular file (" + fileName + ')');
+        }
+        mSize = static_cast<Size>(info.st_size);
+        // An empty file can't be mapped, it simply has no data
+        if (mSize != 0) {
+            void* data = ::mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                ::close(fd);
+                throw Exception("Could not map the file specified (" + fileName + ')');
+            }
+            mData = static_cast<const Byte*>(data);
+            // Only hints, the data is read correctly even if the kernel ignores them
+            ::madvise(data, mSize, MADV_SEQUENTIAL);
+        }
+        // The mapping keeps the file referenced on its own
+        ::close(fd);
+    }
+
+    /// Returns the window of the next at most \p maxSize bytes and moves past it
+    ///
+    /// The window is shorter than \p maxSize only at the end of the file. At EOF, an empty window is
+    /// returned.
+    BufferSlice<const Byte> next(const Size maxSize) {
+        ASSERT(isOpen());
+        const Size size = std::min(maxSize, mSize - mPosition);
+        const Byte* window = mData + mPosition;
+        mPosition += size;
+        adviseWillNeed(mPosition, size);
+        return BufferSlice<const Byte>(window, window + size);
+    }
+
+    /// Returns the whole mapped file, regardless of the position
+    BufferSlice<const Byte> getData() const {
+        ASSERT(isOpen());
+        return BufferSlice<const Byte>(mData, mData + mSize);
+    }
+
+    Size read(void* output, const Size count) override {
+        ASSERT(output != nullptr || count == 0);
+        const BufferSlice<const Byte> window = next(count);
+        if (!window.empty()) {
+            std::memcpy(output, window.data(), window.size());
+        }
+        return window.size();
+    }
+
+    bool eof() const override {
+        ASSERT(isOpen());
+        return mPosition == mSize;
+    }
+
+    /// Unmaps the file, the windows returned so far become invalid
+    /// \throws Exception in case the file couldn't be unmapped
+    void close() override {
+        ASSERT(isOpen());
+        if (closeImpl() != 0) {
+            throw Exception("Failed to unmap file");
+        }
+    }
+
+    /// Returns whether or not the file is mapped
+    bool isOpen() const { return mOpen; }
+
+    /// Returns the size of the file
+    Size getSize() const { return mSize; }
+
+    /// Returns the number of bytes consumed so far
+    Size getPosition() const { return mPosition; }
+
+private:
+    /// Asks the kernel to start reading the given range in the background
+    void adviseWillNeed(const Size offset, const Size size) const {
+        const Size end = std::min(offset + size, mSize);
+        if (offset >= end) {
+            return;
+        }
+        // madvise() requires a page aligned address
+        const Size pageSize = static_cast<Size>(::sysconf(_SC_PAGESIZE));
+        const Size alignedOffset = offset - offset % pageSize;
+        ::madvise(const_cast<Byte*>(mData + alignedOffset), end - alignedOffset, MADV_WILLNEED);
+    }
+
+    int closeImpl() {
+        if (!mOpen) {
+            return 0;
+        }
+        mOpen = false;
+        if (mData == nullptr) {
+            return 0;
+        }
+        const int result = ::munmap(const_cast<Byte*>(mData), mSize);
+        mData = nullptr;
+        return result;
+    }
+
+    const Byte* mData = nullptr;
+    Size mSize = 0;
+    Size mPosition = 0;
+    bool mOpen = true;
+};
+
+} // namespace crypto
+
+#endif // CPPLIBCRYPTO_IO_MAPPEDFILEINPUTSTREAM_H_
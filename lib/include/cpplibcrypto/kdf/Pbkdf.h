@@ -5,8 +5,10 @@
 #include "cpplibcrypto/buffer/Password.h"
 #include "cpplibcrypto/buffer/Salt.h"
 #include "cpplibcrypto/common/Exception.h"
+#include "cpplibcrypto/common/Parallel.h"
 #include "cpplibcrypto/hash/Hmac.h"
 #include "cpplibcrypto/hash/Sha1.h"
+#include "cpplibcrypto/kdf/Pbkdf2Core.h"
 
 #include <algorithm>
 
@@ -35,6 +37,7 @@ public:
         std::swap(mPassword, other.mPassword);
         std::swap(mSalt, other.mSalt);
         std::swap(mKeySet, other.mKeySet);
+        std::swap(mThreadCount, other.mThreadCount);
         return *this;
     }
 
@@ -48,6 +51,13 @@ public:
     /// Sets new salt for the Pbkdf
     void setSalt(Salt salt) { mSalt = std::move(salt); }
 
+    /// Sets the number of threads used to derive the output blocks
+    ///
+    /// The output blocks T_1, T_2, ... are independent of each other, so a key longer than one digest can be
+    /// derived on several cores at once. The calling thread takes part in the work, so 1 (the default)
+    /// derives everything on the calling thread. 0 uses std::thread::hardware_concurrency().
+    void setThreadCount(const Size threadCount) { mThreadCount = threadCount; }
+
     /// Derives key from the given password and salt
     /// \param length Tells how long the derived key should be
     /// \param out The output buffer where the derived key will be stored. Must be at least as big as the
@@ -59,45 +69,50 @@ public:
         if (!mKeySet) {
             throw Exception("PBKDF: Password not set");
         }
+        const Size blockCount = (length + DIGEST_SIZE - 1) / DIGEST_SIZE;
+        const Size threadCount = std::min(blockCount, parallel::resolveThreadCount(mThreadCount));
+        if (threadCount > 1) {
+            deriveParallel(length, out, iterations, blockCount, threadCount);
+            return;
+        }
+
         StaticBuffer<Byte, DIGEST_SIZE> blockBuffer(DIGEST_SIZE);
         Size derived = 0;
-        uint32_t count = 1;
+        Dword count = 1;
         while (derived < length) {
-            mHmac.update(mSalt);
-            StaticBuffer<Byte, 4> countBytes(4);
-            encodeBigEndian(countBytes, count++);
-            mHmac.update(countBytes);
-            mHmac.finalize(blockBuffer);
-
-            StaticBuffer<Byte, DIGEST_SIZE> roundBuffer;
-            roundBuffer << blockBuffer;
+            Pbkdf2Core<THash>::deriveBlock(mHmac.getInnerState(), mHmac.getOuterState(), mSalt.data(),
+                                           mSalt.size(), count++, iterations, blockBuffer.data());
+
             constexpr Size s = DIGEST_SIZE;
             const Size blockSize = std::min(length - derived, s);
-            for (Size c = 1; c < iterations; ++c) {
-                mHmac.reset();
-                mHmac.update(roundBuffer);
-                mHmac.finalize(roundBuffer);
-                for (Size i = 0; i < DIGEST_SIZE; ++i) {
-                    blockBuffer[i] ^= roundBuffer[i];
-                }
-            }
-
             for (Size i = 0; i < blockSize; ++i) {
                 out[derived + i] = blockBuffer[i];
             }
-            mHmac.reset();
             derived += blockSize;
         }
         ASSERT(derived == length);
     }
 
 private:
-    template <typename TBuffer>
-    static void encodeBigEndian(TBuffer& out, const uint32_t in) {
-        out[0] = (in >> 24) & 0xff;
-        out[1] = (in >> 16) & 0xff;
-        out[2] = (in >> 8) & 0xff;
-        out[3] = in & 0xff;
+    /// Derives the blocks on \p threadCount threads, including the calling one. The threads write to disjoint
+    /// parts of one buffer.
+    template <typename TOut>
+    void deriveParallel(const Size length,
+                        TOut& out,
+                        const Size iterations,
+                        const Size blockCount,
+                        const Size threadCount) {
+        DynamicBuffer<Byte> blocks(blockCount * DIGEST_SIZE);
+        blocks.setSensitive();
+        parallel::forEach(blockCount, threadCount, [&](const Size block) {
+            Pbkdf2Core<THash>::deriveBlock(mHmac.getInnerState(), mHmac.getOuterState(), mSalt.data(),
+                                           mSalt.size(), Dword(block + 1), iterations,
+                                           blocks.data() + block * DIGEST_SIZE);
+        });
+
+        for (Size i = 0; i < length; ++i) {
+            out[i] = blocks[i];
+        }
     }
 
     Pbkdf& operator=(const Pbkdf&) = delete;
@@ -107,6 +122,7 @@ private:
     Password mPassword;
     Salt mSalt;
     bool mKeySet = false;
+    Size mThreadCount = 1;
 };
 
 using Pbkdf2 = Pbkdf<Sha1>;
@@ -0,0 +1,99 @@
+#ifndef CPPLIBCRYPTO_KDF_PBKDF2CORE_H_
+#define CPPLIBCRYPTO_KDF_PBKDF2CORE_H_
+
+#include "cpplibcrypto/common/bitManip.h"
+#include "cpplibcrypto/common/Memory.h"
+#include "cpplibcrypto/common/common.h"
+
+namespace crypto {
+
+/// PBKDF2 block function working directly on the HMAC key states
+///
+/// Every iteration U_c = HMAC(P, U_c-1) is exactly two compression calls: the inner one starts from the ipad
+/// state with U_c-1 in an already padded block, the outer one from the opad state with the inner digest in
+/// another padded block. Nothing gets buffered or allocated and the XOR of the U_c is accumulated in the hash
+/// state words. Stateless, so it can be run for different blocks concurrently.
+template <typename THash>
+class Pbkdf2Core final {
+public:
+    using HashState = typename THash::HashState;
+
+    static constexpr Size BLOCK_SIZE = THash::BLOCK_SIZE;
+    static constexpr Size DIGEST_SIZE = THash::DIGEST_SIZE;
+
+    /// Computes the output block T_index = U_1 ^ U_2 ^ ... ^ U_iterations
+    ///
+    /// \param inner The hash state after compressing the key XORed with ipad, see Hmac::getInnerState()
+    /// \param outer The hash state after compressing the key XORed with opad, see Hmac::getOuterState()
+    /// \param salt The salt
+    /// \param saltSize The size of the salt in bytes
+    /// \param index The 1-based index of the output block
+    /// \param iterations The iteration count
+    /// \param out Output for the block, DIGEST_SIZE bytes
+    static void deriveBlock(const HashState& inner,
+                            const HashState& outer,
+                            const Byte* salt,
+                            const Size saltSize,
+                            const Dword index,
+                            const Size iterations,
+                            Byte* out) {
+        // Both the inner and the outer message are the ipad/opad block followed by one digest
+        Byte innerBlock[BLOCK_SIZE];
+        Byte outerBlock[BLOCK_SIZE];
+        THash::padFinalBlock(innerBlock, DIGEST_SIZE, BLOCK_SIZE + DIGEST_SIZE);
+        THash::padFinalBlock(outerBlock, DIGEST_SIZE, BLOCK_SIZE + DIGEST_SIZE);
+
+        HashState state = computeFirst(inner, outer, salt, saltSize, index);
+        HashState accumulator = state;
+
+        for (Size c = 1; c < iterations; ++c) {
+            THash::encodeDigest(state, innerBlock);
+            state = inner;
+            THash::processBlocks(state, innerBlock, 1);
+
+            THash::encodeDigest(state, outerBlock);
+            state = outer;
+            THash::processBlocks(state, outerBlock, 1);
+
+            // The digest is just the state words in a fixed byte order, XORing the words is the same
+            for (Size i = 0; i < accumulator.H.size(); ++i) {
+                accumulator[i] ^= state[i];
+            }
+        }
+        THash::encodeDigest(accumulator, out);
+        memory::wipe(innerBlock, sizeof(innerBlock));
+        memory::wipe(outerBlock, sizeof(outerBlock));
+    }
+
+    /// Computes U_1 = HMAC(P, S || INT(index))
+    ///
+    /// \returns The hash state holding U_1, the parameters are the same as for \ref deriveBlock()
+    static HashState computeFirst(const HashState& inner,
+                                  const HashState& outer,
+                                  const Byte* salt,
+                                  const Size saltSize,
+                                  const Dword index) {
+        // The salt has an arbitrary length so it goes through the hasher
+        THash hasher;
+        hasher.setState(inner, BLOCK_SIZE);
+        hasher.update(salt, saltSize);
+        Byte indexBytes[4];
+        bits::storeBigEndian(indexBytes, index);
+        hasher.update(indexBytes, sizeof(indexBytes));
+        Byte outerBlock[BLOCK_SIZE];
+        THash::padFinalBlock(outerBlock, DIGEST_SIZE, BLOCK_SIZE + DIGEST_SIZE);
+        hasher.finalize(outerBlock);
+
+        HashState state = outer;
+        THash::processBlocks(state, outerBlock, 1);
+        memory::wipe(outerBlock, sizeof(outerBlock));
+        return state;
+    }
+
+private:
+    Pbkdf2Core() = delete;
+};
+
+} // namespace crypto
+
+#endif // CPPLIBCRYPTO_KDF_PBKDF2CORE_H_
@@ -0,0 +1,104 @@
+#ifndef CPPLIBCRYPTO_KDF_PBKDF2SHA256BATCH_H_
+#define CPPLIBCRYPTO_KDF_PBKDF2SHA256BATCH_H_
+
+#include "cpplibcrypto/buffer/DynamicBuffer.h"
+#include "cpplibcrypto/common/Exception.h"
+#include "cpplibcrypto/common/common.h"
+#include "cpplibcrypto/hash/Sha256Batch.h"
+
+namespace crypto {
+
+/// PBKDF2-HMAC-SHA256 for many (password, salt) pairs at once
+///
+/// Every output block of every pair is an independent chain of HMAC computations. The chains are mapped to
+/// the lanes of the multi-buffer SHA-256 compression, so one iteration of up to 16 chains costs two SIMD
+/// compression calls. Meant for bulk work like verifying or re-deriving the keys of many users, a single key
+/// is better served by \ref Pbkdf.
+class Pbkdf2Sha256Batch final {
+public:
+    static constexpr Size DIGEST_SIZE = Sha256Batch::DIGEST_SIZE;
+
+    using Implementation = Sha256Batch::Implementation;
+
+    /// Derives the keys using the fastest implementation supported by the CPU
+    ///
+    /// \param passwords Pointers to the passwords
+    /// \param passwordSizes The sizes of the passwords in bytes
+    /// \param salts Pointers to the salts
+    /// \param saltSizes The sizes of the salts in bytes
+    /// \param count The number of (password, salt) pairs
+    /// \param length The length of each derived key in bytes
+    /// \param iterations The iteration count, the same for all the pairs
+    /// \param out Output for the keys, \p length bytes per pair in the order of the pairs
+    static void derive(const Byte* const* passwords,
+                       const Size* passwordSizes,
+                       const Byte* const* salts,
+                       const Size* saltSizes,
+                       const Size count,
+                       const Size length,
+                       const Size iterations,
+                       Byte* out) {
+        derive(passwords, passwordSizes, salts, saltSizes, count, length, iterations, out,
+               Sha256Batch::getDefaultImplementation());
+    }
+
+    /// Derives the keys using the given implementation
+    ///
+    /// \param passwords Pointers to the passwords
+    /// \param passwordSizes The sizes of the passwords in bytes
+    /// \param salts Pointers to the salts
+    /// \param saltSizes The sizes of the salts in bytes
+    /// \param count The number of (password, salt) pairs
+    /// \param length The length of each derived key in bytes
+    /// \param iterations The iteration count, the same for all the pairs
+    /// \param out Output for the keys, \p length bytes per pair in the order of the pairs
+    /// \param implementation The implementation to use
+    /// \throws Exception if the implementation is not supported on this CPU
+    static void derive(const Byte* const* passwords,
+                       const Size* passwordSizes,
+                       const Byte* const* salts,
+                       const Size* saltSizes,
+                       Size count,
+                       Size length,
+                       Size iterations,
+                       Byte* out,
+                       Implementation implementation);
+
+    /// Derives the keys for the given passwords and salts
+    ///
+    /// \param passwords A container of passwords, each providing data() and size()
+    /// \param salts A container of salts, each providing data() and size(), one per password
+    /// \param length The length of each derived key in bytes
+    /// \param out Output for the keys, must hold \p length bytes per password
+    /// \param iterations The iteration count, the same for all the pairs
+    template <typename TPasswords, typename TSalts, typename TOut>
+    static void derive(const TPasswords& passwords,
+                       const TSalts& salts,
+                       const Size length,
+                       TOut& out,
+                       const Size iterations) {
+        DynamicBuffer<const Byte*> passwordPointers;
+        DynamicBuffer<Size> passwordSizes;
+        for (const auto& password : passwords) {
+            passwordPointers.push(password.data());
+            passwordSizes.push(password.size());
+        }
+        DynamicBuffer<const Byte*> saltPointers;
+        DynamicBuffer<Size> saltSizes;
+        for (const auto& salt : salts) {
+            saltPointers.push(salt.data());
+            saltSizes.push(salt.size());
+        }
+        ASSERT(saltPointers.size() == passwordPointers.size());
+        ASSERT(out.size() >= passwordPointers.size() * length);
+        derive(passwordPointers.data(), passwordSizes.data(), saltPointers.data(), saltSizes.data(),
+               passwordPointers.size(), length, iterations, out.data());
+    }
+
+private:
+    Pbkdf2Sha256Batch() = delete;
+};
+
+} // namespace crypto
+
+#endif // CPPLIBCRYPTO_KDF_PBKDF2SHA256BATCH_H_
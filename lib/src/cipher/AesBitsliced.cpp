@@ -0,0 +1,409 @@
+#include "cpplibcrypto/cipher/AesBitsliced.h"
+#include "cpplibcrypto/common/Cpu.h"
+
+#include <cstring>
+
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
+namespace crypto {
+
+void AesBitsliced::expandKey(const Byte* roundKeys, const Byte rounds, Byte* keys) {
+    for (Size round = 0; round <= rounds; ++round) {
+        const Byte* roundKey = roundKeys + 16 * round;
+        Byte* planes = keys + ROUND_KEY_SIZE * round;
+        for (Size bit = 0; bit < 8; ++bit) {
+            for (Size i = 0; i < 16; ++i) {
+                planes[16 * bit + i] = static_cast<Byte>(0 - ((roundKey[i] >> bit) & 1));
+            }
+        }
+    }
+}
+
+#ifdef __SSSE3__
+
+namespace {
+
+// The state is kept in eight registers, q[i] holds bit i of the bytes. Byte k of a register corresponds to
+// byte k of the AES state and its bit j to the j-th of the blocks (in reverse order, which does not matter as
+// long as the conversion back reverses it as well). The operators on __m128i are the GCC vector extensions.
+
+/// Swaps the bits of b selected by the mask with the bits of a selected by the mask shifted by n
+inline void swapMove(__m128i& a, __m128i& b, const int n, const __m128i mask) {
+    const __m128i t = (_mm_srli_epi64(a, n) ^ b) & mask;
+    b ^= t;
+    a ^= _mm_slli_epi64(t, n);
+}
+
+/// Transposes the 8x8 bit matrix in every byte position of the eight registers. It is its own inverse.
+void transpose(__m128i* x) {
+    const __m128i m1 = _mm_set1_epi8(0x55);
+    const __m128i m2 = _mm_set1_epi8(0x33);
+    const __m128i m4 = _mm_set1_epi8(0x0f);
+    swapMove(x[1], x[0], 1, m1);
+    swapMove(x[3], x[2], 1, m1);
+    swapMove(x[5], x[4], 1, m1);
+    swapMove(x[7], x[6], 1, m1);
+    swapMove(x[2], x[0], 2, m2);
+    swapMove(x[3], x[1], 2, m2);
+    swapMove(x[6], x[4], 2, m2);
+    swapMove(x[7], x[5], 2, m2);
+    swapMove(x[4], x[0], 4, m4);
+    swapMove(x[5], x[1], 4, m4);
+    swapMove(x[6], x[2], 4, m4);
+    swapMove(x[7], x[3], 4, m4);
+}
+
+/// Converts eight blocks to the bitsliced state
+void load(const Byte* in, __m128i* q) {
+    __m128i x[8];
+    for (Size i = 0; i < 8; ++i) {
+        x[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in) + i);
+    }
+    transpose(x);
+    // The transposition leaves the most significant bit in the first register
+    for (Size i = 0; i < 8; ++i) {
+        q[i] = x[7 - i];
+    }
+}
+
+/// Converts the bitsliced state back to eight blocks
+void store(const __m128i* q, Byte* out) {
+    __m128i x[8];
+    for (Size i = 0; i < 8; ++i) {
+        x[7 - i] = q[i];
+    }
+    transpose(x);
+    for (Size i = 0; i < 8; ++i) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out) + i, x[i]);
+    }
+}
+
+void addRoundKey(__m128i* q, const Byte* key) {
+    for (Size i = 0; i < 8; ++i) {
+        q[i] ^= _mm_loadu_si128(reinterpret_cast<const __m128i*>(key) + i);
+    }
+}
+
+/// The S-box circuit by Boyar and Peralta ("A depth-16 circuit for the AES S-box"), 113 gates
+void subBytes(__m128i* q) {
+    const __m128i ones = _mm_set1_epi8(-1);
+    const __m128i x0 = q[7];
+    const __m128i x1 = q[6];
+    const __m128i x2 = q[5];
+    const __m128i x3 = q[4];
+    const __m128i x4 = q[3];
+    const __m128i x5 = q[2];
+    const __m128i x6 = q[1];
+    const __m128i x7 = q[0];
+
+    // Top linear transformation
+    const __m128i y14 = x3 ^ x5;
+    const __m128i y13 = x0 ^ x6;
+    const __m128i y9 = x0 ^ x3;
+    const __m128i y8 = x0 ^ x5;
+    const __m128i t0 = x1 ^ x2;
+    const __m128i y1 = t0 ^ x7;
+    const __m128i y4 = y1 ^ x3;
+    const __m128i y12 = y13 ^ y14;
+    const __m128i y2 = y1 ^ x0;
+    const __m128i y5 = y1 ^ x6;
+    const __m128i y3 = y5 ^ y8;
+    const __m128i t1 = x4 ^ y12;
+    const __m128i y15 = t1 ^ x5;
+    const __m128i y20 = t1 ^ x1;
+    const __m128i y6 = y15 ^ x7;
+    const __m128i y10 = y15 ^ t0;
+    const __m128i y11 = y20 ^ y9;
+    const __m128i y7 = x7 ^ y11;
+    const __m128i y17 = y10 ^ y11;
+    const __m128i y19 = y10 ^ y8;
+    const __m128i y16 = t0 ^ y11;
+    const __m128i y21 = y13 ^ y16;
+    const __m128i y18 = x0 ^ y16;
+
+    // Inversion in GF(2^8)
+    const __m128i t2 = y12 & y15;
+    const __m128i t3 = y3 & y6;
+    const __m128i t4 = t3 ^ t2;
+    const __m128i t5 = y4 & x7;
+    const __m128i t6 = t5 ^ t2;
+    const __m128i t7 = y13 & y16;
+    const __m128i t8 = y5 & y1;
+    const __m128i t9 = t8 ^ t7;
+    const __m128i t10 = y2 & y7;
+    const __m128i t11 = t10 ^ t7;
+    const __m128i t12 = y9 & y11;
+    const __m128i t13 = y14 & y17;
+    const __m128i t14 = t13 ^ t12;
+    const __m128i t15 = y8 & y10;
+    const __m128i t16 = t15 ^ t12;
+    const __m128i t17 = t4 ^ t14;
+    const __m128i t18 = t6 ^ t16;
+    const __m128i t19 = t9 ^ t14;
+    const __m128i t20 = t11 ^ t16;
+    const __m128i t21 = t17 ^ y20;
+    const __m128i t22 = t18 ^ y19;
+    const __m128i t23 = t19 ^ y21;
+    const __m128i t24 = t20 ^ y18;
+
+    const __m128i t25 = t21 ^ t22;
+    const __m128i t26 = t21 & t23;
+    const __m128i t27 = t24 ^ t26;
+    const __m128i t28 = t25 & t27;
+    const __m128i t29 = t28 ^ t22;
+    const __m128i t30 = t23 ^ t24;
+    const __m128i t31 = t22 ^ t26;
+    const __m128i t32 = t31 & t30;
+    const __m128i t33 = t32 ^ t24;
+    const __m128i t34 = t23 ^ t33;
+    const __m128i t35 = t27 ^ t33;
+    const __m128i t36 = t24 & t35;
+    const __m128i t37 = t36 ^ t34;
+    const __m128i t38 = t27 ^ t36;
+    const __m128i t39 = t29 & t38;
+    const __m128i t40 = t25 ^ t39;
+
+    const __m128i t41 = t40 ^ t37;
+    const __m128i t42 = t29 ^ t33;
+    const __m128i t43 = t29 ^ t40;
+    const __m128i t44 = t33 ^ t37;
+    const __m128i t45 = t42 ^ t41;
+    const __m128i z0 = t44 & y15;
+    const __m128i z1 = t37 & y6;
+    const __m128i z2 = t33 & x7;
+    const __m128i z3 = t43 & y16;
+    const __m128i z4 = t40 & y1;
+    const __m128i z5 = t29 & y7;
+    const __m128i z6 = t42 & y11;
+    const __m128i z7 = t45 & y17;
+    const __m128i z8 = t41 & y10;
+    const __m128i z9 = t44 & y12;
+    const __m128i z10 = t37 & y3;
+    const __m128i z11 = t33 & y4;
+    const __m128i z12 = t43 & y13;
+    const __m128i z13 = t40 & y5;
+    const __m128i z14 = t29 & y2;
+    const __m128i z15 = t42 & y9;
+    const __m128i z16 = t45 & y14;
+    const __m128i z17 = t41 & y8;
+
+    // Bottom linear transformation, including the affine constant
+    const __m128i t46 = z15 ^ z16;
+    const __m128i t47 = z10 ^ z11;
+    const __m128i t48 = z5 ^ z13;
+    const __m128i t49 = z9 ^ z10;
+    const __m128i t50 = z2 ^ z12;
+    const __m128i t51 = z2 ^ z5;
+    const __m128i t52 = z7 ^ z8;
+    const __m128i t53 = z0 ^ z3;
+    const __m128i t54 = z6 ^ z7;
+    const __m128i t55 = z16 ^ z17;
+    const __m128i t56 = z12 ^ t48;
+    const __m128i t57 = t50 ^ t53;
+    const __m128i t58 = z4 ^ t46;
+    const __m128i t59 = z3 ^ t54;
+    const __m128i t60 = t46 ^ t57;
+    const __m128i t61 = z14 ^ t57;
+    const __m128i t62 = t52 ^ t58;
+    const __m128i t63 = t49 ^ t58;
+    const __m128i t64 = z4 ^ t59;
+    const __m128i t65 = t61 ^ t62;
+    const __m128i t66 = z1 ^ t63;
+    const __m128i t67 = t64 ^ t65;
+    const __m128i s3 = t53 ^ t66;
+
+    q[7] = t59 ^ t63;
+    q[6] = t64 ^ s3 ^ ones;
+    q[5] = t55 ^ t67 ^ ones;
+    q[4] = s3;
+    q[3] = t51 ^ t66;
+    q[2] = t47 ^ t65;
+    q[1] = t56 ^ t62 ^ ones;
+    q[0] = t48 ^ t60 ^ ones;
+}
+
+/// Inverse of the affine transformation of the S-box, including the constant
+void inverseAffine(__m128i* q) {
+    const __m128i ones = _mm_set1_epi8(-1);
+    const __m128i q0 = q[0] ^ ones;
+    const __m128i q1 = q[1] ^ ones;
+    const __m128i q2 = q[2];
+    const __m128i q3 = q[3];
+    const __m128i q4 = q[4];
+    const __m128i q5 = q[5] ^ ones;
+    const __m128i q6 = q[6] ^ ones;
+    const __m128i q7 = q[7];
+    q[7] = q1 ^ q4 ^ q6;
+    q[6] = q0 ^ q3 ^ q5;
+    q[5] = q7 ^ q2 ^ q4;
+    q[4] = q6 ^ q1 ^ q3;
+    q[3] = q5 ^ q0 ^ q2;
+    q[2] = q4 ^ q7 ^ q1;
+    q[1] = q3 ^ q6 ^ q0;
+    q[0] = q2 ^ q5 ^ q7;
+}
+
+/// S^-1(y) = A^-1(S(A^-1(y))), the S-box is the inversion followed by the affine transformation A
+void invSubBytes(__m128i* q) {
+    inverseAffine(q);
+    subBytes(q);
+    inverseAffine(q);
+}
+
+void shuffleBytes(__m128i* q, const __m128i mask) {
+    for (Size i = 0; i < 8; ++i) {
+        q[i] = _mm_shuffle_epi8(q[i], mask);
+    }
+}
+
+void shiftRows(__m128i* q) {
+    shuffleBytes(q, _mm_setr_epi8(0, 5, 10, 15, 4, 9, 14, 3, 8, 13, 2, 7, 12, 1, 6, 11));
+}
+
+void invShiftRows(__m128i* q) {
+    shuffleBytes(q, _mm_setr_epi8(0, 13, 10, 7, 4, 1, 14, 11, 8, 5, 2, 15, 12, 9, 6, 3));
+}
+
+/// Moves row r + 1 of every column to row r, the columns are the 32-bit words
+inline __m128i rotateRows1(const __m128i x) {
+    return _mm_srli_epi32(x, 8) | _mm_slli_epi32(x, 24);
+}
+
+/// Moves row r + 2 of every column to row r
+inline __m128i rotateRows2(const __m128i x) {
+    return _mm_srli_epi32(x, 16) | _mm_slli_epi32(x, 16);
+}
+
+/// Multiplies all the bytes by x in GF(2^8), the reduction by x^8 + x^4 + x^3 + x + 1 feeds the top bit back
+void multiplyByX(const __m128i* in, __m128i* out) {
+    const __m128i top = in[7];
+    out[7] = in[6];
+    out[6] = in[5];
+    out[5] = in[4];
+    out[4] = in[3] ^ top;
+    out[3] = in[2] ^ top;
+    out[2] = in[1];
+    out[1] = in[0] ^ top;
+    out[0] = top;
+}
+
+/// a'_r = 2 a_r + 3 a_r+1 + a_r+2 + a_r+3 = 2 (a_r + a_r+1) + a_r+1 + rot2(a_r + a_r+1)
+void mixColumns(__m128i* q) {
+    __m128i rotated[8];
+    __m128i t[8];
+    for (Size i = 0; i < 8; ++i) {
+        rotated[i] = rotateRows1(q[i]);
+        t[i] = q[i] ^ rotated[i];
+    }
+    __m128i doubled[8];
+    multiplyByX(t, doubled);
+    for (Size i = 0; i < 8; ++i) {
+        q[i] = doubled[i] ^ rotated[i] ^ rotateRows2(t[i]);
+    }
+}
+
+/// The inverse MixColumns matrix is the forward one times (5 0 4 0), so a_r + 4 (a_r + a_r+2) is mixed
+void invMixColumns(__m128i* q) {
+    __m128i t[8];
+    for (Size i = 0; i < 8; ++i) {
+        t[i] = q[i] ^ rotateRows2(q[i]);
+    }
+    __m128i doubled[8];
+    multiplyByX(t, doubled);
+    multiplyByX(doubled, t);
+    for (Size i = 0; i < 8; ++i) {
+        q[i] ^= t[i];
+    }
+    mixColumns(q);
+}
+
+void encrypt8(const Byte* keys, const Byte rounds, const Byte* in, Byte* out) {
+    __m128i q[8];
+    load(in, q);
+    addRoundKey(q, keys);
+    for (Byte round = 1; round < rounds; ++round) {
+        subBytes(q);
+        shiftRows(q);
+        mixColumns(q);
+        addRoundKey(q, keys + AesBitsliced::ROUND_KEY_SIZE * round);
+    }
+    subBytes(q);
+    shiftRows(q);
+    addRoundKey(q, keys + AesBitsliced::ROUND_KEY_SIZE * rounds);
+    store(q, out);
+}
+
+void decrypt8(const Byte* keys, const Byte rounds, const Byte* in, Byte* out) {
+    __m128i q[8];
+    load(in, q);
+    addRoundKey(q, keys + AesBitsliced::ROUND_KEY_SIZE * rounds);
+    for (Byte round = rounds - 1; round > 0; --round) {
+        invShiftRows(q);
+        invSubBytes(q);
+        addRoundKey(q, keys + AesBitsliced::ROUND_KEY_SIZE * round);
+        invMixColumns(q);
+    }
+    invShiftRows(q);
+    invSubBytes(q);
+    addRoundKey(q, keys);
+    store(q, out);
+}
+
+using Process8 = void (*)(const Byte*, Byte, const Byte*, Byte*);
+
+void processBlocks(const Process8 process8,
+                   const Byte* keys,
+                   const Byte rounds,
+                   const Byte* in,
+                   Byte* out,
+                   Size nBlocks) {
+    constexpr Size BATCH_SIZE = 16 * AesBitsliced::LANES;
+    for (; nBlocks >= AesBitsliced::LANES; nBlocks -= AesBitsliced::LANES) {
+        process8(keys, rounds, in, out);
+        in += BATCH_SIZE;
+        out += BATCH_SIZE;
+    }
+    if (nBlocks > 0) {
+        // The unused lanes are computed as well, they just get thrown away
+        Byte batch[BATCH_SIZE] = {};
+        std::memcpy(batch, in, 16 * nBlocks);
+        process8(keys, rounds, batch, batch);
+        std::memcpy(out, batch, 16 * nBlocks);
+    }
+}
+
+} // namespace
+
+bool AesBitsliced::isSupported() {
+    return Cpu::hasSsse3();
+}
+
+void AesBitsliced::encryptBlocks(
+    const Byte* keys, const Byte rounds, const Byte* in, Byte* out, const Size nBlocks) {
+    processBlocks(encrypt8, keys, rounds, in, out, nBlocks);
+}
+
+void AesBitsliced::decryptBlocks(
+    const Byte* keys, const Byte rounds, const Byte* in, Byte* out, const Size nBlocks) {
+    processBlocks(decrypt8, keys, rounds, in, out, nBlocks);
+}
+
+#else
+
+bool AesBitsliced::isSupported() {
+    return false;
+}
+
+void AesBitsliced::encryptBlocks(const Byte*, Byte, const Byte*, Byte*, Size) {
+    ASSERT(false);
+}
+
+void AesBitsliced::decryptBlocks(const Byte*, Byte, const Byte*, Byte*, Size) {
+    ASSERT(false);
+}
+
+#endif
+
+} // namespace crypto
@@ -0,0 +1,150 @@
+#include "cpplibcrypto/cipher/AesNi.h"
+#include "cpplibcrypto/common/Cpu.h"
+
+#ifdef __AES__
+#include <wmmintrin.h>
+#endif
+
+namespace crypto {
+
+#ifdef __AES__
+
+namespace {
+
+__m128i loadRoundKey(const Byte* keys, const Size round) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + 16 * round));
+}
+
+/// Number of blocks processed in parallel by the bulk functions
+constexpr Size LANES = 8;
+
+template <Size N>
+void loadBlocks(const Byte* in, __m128i* blocks) {
+    for (Size i = 0; i < N; ++i) {
+        blocks[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in) + i);
+    }
+}
+
+template <Size N>
+void storeBlocks(const __m128i* blocks, Byte* out) {
+    for (Size i = 0; i < N; ++i) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out) + i, blocks[i]);
+    }
+}
+
+} // namespace
+
+bool AesNi::isSupported() {
+    return Cpu::hasAesNi();
+}
+
+void AesNi::expandDecryptionKey(const Byte* encKeys, const Byte rounds, Byte* decKeys) {
+    auto* out = reinterpret_cast<__m128i*>(decKeys);
+    _mm_storeu_si128(out, loadRoundKey(encKeys, rounds));
+    for (Byte round = 1; round < rounds; ++round) {
+        _mm_storeu_si128(out + round, _mm_aesimc_si128(loadRoundKey(encKeys, rounds - round)));
+    }
+    _mm_storeu_si128(out + rounds, loadRoundKey(encKeys, 0));
+}
+
+void AesNi::encryptBlock(const Byte* encKeys, const Byte rounds, const Byte* in, Byte* out) {
+    __m128i state = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+    state = _mm_xor_si128(state, loadRoundKey(encKeys, 0));
+    for (Byte round = 1; round < rounds; ++round) {
+        state = _mm_aesenc_si128(state, loadRoundKey(encKeys, round));
+    }
+    state = _mm_aesenclast_si128(state, loadRoundKey(encKeys, rounds));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), state);
+}
+
+void AesNi::decryptBlock(const Byte* decKeys, const Byte rounds, const Byte* in, Byte* out) {
+    __m128i state = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+    state = _mm_xor_si128(state, loadRoundKey(decKeys, 0));
+    for (Byte round = 1; round < rounds; ++round) {
+        state = _mm_aesdec_si128(state, loadRoundKey(decKeys, round));
+    }
+    state = _mm_aesdeclast_si128(state, loadRoundKey(decKeys, rounds));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), state);
+}
+
+void AesNi::encryptBlocks(const Byte* encKeys, const Byte rounds, const Byte* in, Byte* out, Size nBlocks) {
+    // The blocks are independent, interleaving them keeps the AES unit busy instead of waiting for the result
+    // of the previous round of a single block
+    __m128i blocks[LANES];
+    for (; nBlocks >= LANES; nBlocks -= LANES, in += 16 * LANES, out += 16 * LANES) {
+        loadBlocks<LANES>(in, blocks);
+        const __m128i first = loadRoundKey(encKeys, 0);
+        for (Size i = 0; i < LANES; ++i) {
+            blocks[i] = _mm_xor_si128(blocks[i], first);
+        }
+        for (Byte round = 1; round < rounds; ++round) {
+            const __m128i key = loadRoundKey(encKeys, round);
+            for (Size i = 0; i < LANES; ++i) {
+                blocks[i] = _mm_aesenc_si128(blocks[i], key);
+            }
+        }
+        const __m128i last = loadRoundKey(encKeys, rounds);
+        for (Size i = 0; i < LANES; ++i) {
+            blocks[i] = _mm_aesenclast_si128(blocks[i], last);
+        }
+        storeBlocks<LANES>(blocks, out);
+    }
+    for (; nBlocks > 0; --nBlocks, in += 16, out += 16) {
+        encryptBlock(encKeys, rounds, in, out);
+    }
+}
+
+void AesNi::decryptBlocks(const Byte* decKeys, const Byte rounds, const Byte* in, Byte* out, Size nBlocks) {
+    __m128i blocks[LANES];
+    for (; nBlocks >= LANES; nBlocks -= LANES, in += 16 * LANES, out += 16 * LANES) {
+        loadBlocks<LANES>(in, blocks);
+        const __m128i first = loadRoundKey(decKeys, 0);
+        for (Size i = 0; i < LANES; ++i) {
+            blocks[i] = _mm_xor_si128(blocks[i], first);
+        }
+        for (Byte round = 1; round < rounds; ++round) {
+            const __m128i key = loadRoundKey(decKeys, round);
+            for (Size i = 0; i < LANES; ++i) {
+                blocks[i] = _mm_aesdec_si128(blocks[i], key);
+            }
+        }
+        const __m128i last = loadRoundKey(decKeys, rounds);
+        for (Size i = 0; i < LANES; ++i) {
+            blocks[i] = _mm_aesdeclast_si128(blocks[i], last);
+        }
+        storeBlocks<LANES>(blocks, out);
+    }
+    for (; nBlocks > 0; --nBlocks, in += 16, out += 16) {
+        decryptBlock(decKeys, rounds, in, out);
+    }
+}
+
+#else
+
+bool AesNi::isSupported() {
+    return false;
+}
+
+void AesNi::expandDecryptionKey(const Byte*, const Byte, Byte*) {
+    ASSERT(false);
+}
+
+void AesNi::encryptBlock(const Byte*, const Byte, const Byte*, Byte*) {
+    ASSERT(false);
+}
+
+void AesNi::decryptBlock(const Byte*, const Byte, const Byte*, Byte*) {
+    ASSERT(false);
+}
+
+void AesNi::encryptBlocks(const Byte*, const Byte, const Byte*, Byte*, Size) {
+    ASSERT(false);
+}
+
+void AesNi::decryptBlocks(const Byte*, const Byte, const Byte*, Byte*, Size) {
+    ASSERT(false);
+}
+
+#endif
+
+} // namespace crypto
@@ -0,0 +1,128 @@
+#include "cpplibcrypto/cipher/GhashClmul.h"
+#include "cpplibcrypto/common/Cpu.h"
+
+#if defined(__PCLMUL__) && defined(__SSSE3__)
+#include <tmmintrin.h>
+#include <wmmintrin.h>
+#define CPPLIBCRYPTO_GHASH_CLMUL
+#endif
+
+namespace crypto {
+
+#ifdef CPPLIBCRYPTO_GHASH_CLMUL
+
+namespace {
+
+// GHASH works with bit-reflected polynomials. With the bytes of a block reversed, the carry-less product only
+// needs to be shifted left by one bit to match the reflected representation (Intel white paper "Intel
+// Carry-Less Multiplication Instruction and its Usage for Computing the GCM Mode", algorithms 2 and 4).
+
+__m128i loadBlock(const Byte* in) {
+    const __m128i reverse = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    return _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)), reverse);
+}
+
+void storeBlock(Byte* out, const __m128i block) {
+    const __m128i reverse = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_shuffle_epi8(block, reverse));
+}
+
+/// Computes the 256-bit carry-less product of a and b and adds it to lo:hi
+void multiplyAccumulate(const __m128i a, const __m128i b, __m128i& lo, __m128i& hi) {
+    const __m128i middle = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10), _mm_clmulepi64_si128(a, b, 0x01));
+    lo = _mm_xor_si128(lo, _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x00), _mm_slli_si128(middle, 8)));
+    hi = _mm_xor_si128(hi, _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x11), _mm_srli_si128(middle, 8)));
+}
+
+/// Reduces the 256-bit product lo:hi modulo x^128 + x^7 + x^2 + x + 1
+__m128i reduce(__m128i lo, __m128i hi) {
+    // Shift the product left by one bit
+    const __m128i loCarry = _mm_srli_epi32(lo, 31);
+    const __m128i hiCarry = _mm_srli_epi32(hi, 31);
+    lo = _mm_or_si128(_mm_slli_epi32(lo, 1), _mm_slli_si128(loCarry, 4));
+    hi = _mm_or_si128(_mm_slli_epi32(hi, 1), _mm_slli_si128(hiCarry, 4));
+    hi = _mm_or_si128(hi, _mm_srli_si128(loCarry, 12));
+
+    // First phase of the reduction
+    __m128i t = _mm_xor_si128(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30));
+    t = _mm_xor_si128(t, _mm_slli_epi32(lo, 25));
+    const __m128i carry = _mm_srli_si128(t, 4);
+    lo = _mm_xor_si128(lo, _mm_slli_si128(t, 12));
+
+    // Second phase of the reduction
+    t = _mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2));
+    t = _mm_xor_si128(t, _mm_srli_epi32(lo, 7));
+    t = _mm_xor_si128(t, carry);
+    return _mm_xor_si128(hi, _mm_xor_si128(lo, t));
+}
+
+__m128i multiply(const __m128i a, const __m128i b) {
+    __m128i lo = _mm_setzero_si128();
+    __m128i hi = _mm_setzero_si128();
+    multiplyAccumulate(a, b, lo, hi);
+    return reduce(lo, hi);
+}
+
+__m128i loadKey(const Byte* table, const Size power) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(table) + power - 1);
+}
+
+} // namespace
+
+bool GhashClmul::isSupported() {
+    return Cpu::hasPclmul();
+}
+
+void GhashClmul::expandKey(const Byte* h, Byte* table) {
+    auto* out = reinterpret_cast<__m128i*>(table);
+    const __m128i h1 = loadBlock(h);
+    _mm_storeu_si128(out, h1);
+    for (Size i = 1; i < 4; ++i) {
+        _mm_storeu_si128(out + i, multiply(_mm_loadu_si128(out + i - 1), h1));
+    }
+}
+
+void GhashClmul::update(Byte* state, const Byte* table, const Byte* data, Size nBlocks) {
+    __m128i x = loadBlock(state);
+
+    // X = (X + C1) * H^4 + C2 * H^3 + C3 * H^2 + C4 * H, reduced only once
+    if (nBlocks >= 4) {
+        const __m128i h1 = loadKey(table, 1);
+        const __m128i h2 = loadKey(table, 2);
+        const __m128i h3 = loadKey(table, 3);
+        const __m128i h4 = loadKey(table, 4);
+        for (; nBlocks >= 4; nBlocks -= 4, data += 64) {
+            __m128i lo = _mm_setzero_si128();
+            __m128i hi = _mm_setzero_si128();
+            multiplyAccumulate(_mm_xor_si128(x, loadBlock(data)), h4, lo, hi);
+            multiplyAccumulate(loadBlock(data + 16), h3, lo, hi);
+            multiplyAccumulate(loadBlock(data + 32), h2, lo, hi);
+            multiplyAccumulate(loadBlock(data + 48), h1, lo, hi);
+            x = reduce(lo, hi);
+        }
+    }
+
+    const __m128i h1 = loadKey(table, 1);
+    for (; nBlocks > 0; --nBlocks, data += 16) {
+        x = multiply(_mm_xor_si128(x, loadBlock(data)), h1);
+    }
+    storeBlock(state, x);
+}
+
+#else
+
+bool GhashClmul::isSupported() {
+    return false;
+}
+
+void GhashClmul::expandKey(const Byte*, Byte*) {
+    ASSERT(false);
+}
+
+void GhashClmul::update(Byte*, const Byte*, const Byte*, Size) {
+    ASSERT(false);
+}
+
+#endif
+
+} // namespace crypto
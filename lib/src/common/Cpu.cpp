@@ -0,0 +1,83 @@
+#include "cpplibcrypto/common/Cpu.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#define CPPLIBCRYPTO_X86
+#endif
+
+namespace crypto {
+
+namespace {
+
+struct CpuFeatures {
+    bool aesNi = false;
+    bool ssse3 = false;
+    bool pclmul = false;
+    bool sha = false;
+    bool avx2 = false;
+    bool avx512 = false;
+};
+
+CpuFeatures detectFeatures() {
+    CpuFeatures features;
+#ifdef CPPLIBCRYPTO_X86
+    unsigned int eax, ebx, ecx, edx;
+    bool ymmEnabled = false;
+    bool zmmEnabled = false;
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        features.aesNi = (ecx & bit_AES) != 0;
+        features.ssse3 = (ecx & bit_SSSE3) != 0;
+        features.pclmul = (ecx & bit_PCLMUL) != 0 && (ecx & bit_SSSE3) != 0;
+        features.sha = (ecx & bit_SSE4_1) != 0;
+        if ((ecx & bit_OSXSAVE) != 0 && (ecx & bit_AVX) != 0) {
+            // XCR0 bits 1 and 2, the OS saves both the XMM and the YMM state on context switches
+            unsigned int xcr0, xcr0High;
+            __asm__("xgetbv" : "=a"(xcr0), "=d"(xcr0High) : "c"(0));
+            ymmEnabled = (xcr0 & 0x6) == 0x6;
+            // Bits 5 to 7, the opmask registers and both halves of the 32 ZMM registers
+            zmmEnabled = ymmEnabled && (xcr0 & 0xe0) == 0xe0;
+        }
+    }
+    if (__get_cpuid_max(0, nullptr) >= 7 && __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        features.sha = features.sha && (ebx & bit_SHA) != 0;
+        features.avx2 = ymmEnabled && (ebx & bit_AVX2) != 0;
+        features.avx512 = zmmEnabled && (ebx & bit_AVX512F) != 0;
+    } else {
+        features.sha = false;
+    }
+#endif
+    return features;
+}
+
+const CpuFeatures& getFeatures() {
+    static const CpuFeatures features = detectFeatures();
+    return features;
+}
+
+} // namespace
+
+bool Cpu::hasAesNi() {
+    return getFeatures().aesNi;
+}
+
+bool Cpu::hasSsse3() {
+    return getFeatures().ssse3;
+}
+
+bool Cpu::hasPclmul() {
+    return getFeatures().pclmul;
+}
+
+bool Cpu::hasSha() {
+    return getFeatures().sha;
+}
+
+bool Cpu::hasAvx2() {
+    return getFeatures().avx2;
+}
+
+bool Cpu::hasAvx512() {
+    return getFeatures().avx512;
+}
+
+} // namespace crypto
@@ -0,0 +1,169 @@
+#include "cpplibcrypto/hash/Sha256Batch.h"
+#include "cpplibcrypto/hash/Sha256MultiBuffer.h"
+#include "cpplibcrypto/hash/Sha2.h"
+
+#include <cstring>
+
+namespace crypto {
+
+namespace {
+
+/// Progress of the message assigned to one lane
+struct Lane {
+    bool active = false;
+    Size message = 0;
+    /// The next block to compress
+    Size block = 0;
+    /// The number of whole blocks compressed straight from the message
+    Size fullBlocks = 0;
+    /// The number of all the blocks, including the one or two padded ones
+    Size totalBlocks = 0;
+    /// The trailing partial block of the message with the padding
+    Byte tail[2 * Sha256Batch::BLOCK_SIZE];
+};
+
+using ProcessBlock = void (*)(Dword*, const Byte* const*);
+
+void assign(Lane& lane, const Size message, const Byte* data, const Size size) {
+    constexpr Size BLOCK_SIZE = Sha256Batch::BLOCK_SIZE;
+    lane.active = true;
+    lane.message = message;
+    lane.block = 0;
+    lane.fullBlocks = size / BLOCK_SIZE;
+
+    // The tail gets the 0x80 byte and the 8 byte length, if they don't fit it spans two blocks
+    const Size remaining = size % BLOCK_SIZE;
+    const Size tailBlocks = remaining + 1 + 8 > BLOCK_SIZE ? 2 : 1;
+    lane.totalBlocks = lane.fullBlocks + tailBlocks;
+    std::memset(lane.tail, 0, sizeof(lane.tail));
+    if (remaining > 0) {
+        std::memcpy(lane.tail, data + lane.fullBlocks * BLOCK_SIZE, remaining);
+    }
+    lane.tail[remaining] = 0x80;
+    bits::storeBigEndian(lane.tail + tailBlocks * BLOCK_SIZE - 8, Qword(size) * 8);
+}
+
+void hashLanes(const Byte* const* messages,
+               const Size* sizes,
+               const Size count,
+               Byte* digests,
+               const Size laneCount,
+               const ProcessBlock processBlock) {
+    constexpr Size BLOCK_SIZE = Sha256Batch::BLOCK_SIZE;
+    static const Byte idleBlock[BLOCK_SIZE] = {};
+    const sha::State<sha::Family::SHA256> initialState;
+
+    Lane lanes[Sha256MultiBuffer::AVX512_LANES];
+    alignas(64) Dword state[8 * Sha256MultiBuffer::AVX512_LANES];
+    const Byte* blocks[Sha256MultiBuffer::AVX512_LANES];
+    ASSERT(laneCount <= Sha256MultiBuffer::AVX512_LANES);
+
+    Size next = 0;
+    const auto refill = [&](const Size index) {
+        Lane& lane = lanes[index];
+        if (next == count) {
+            lane.active = false;
+            return;
+        }
+        assign(lane, next, messages[next], sizes[next]);
+        ++next;
+        for (Size word = 0; word < 8; ++word) {
+            state[word * laneCount + index] = initialState[word];
+        }
+    };
+
+    Size active = 0;
+    for (Size index = 0; index < laneCount; ++index) {
+        refill(index);
+        active += lanes[index].active ? 1 : 0;
+    }
+
+    while (active > 0) {
+        for (Size index = 0; index < laneCount; ++index) {
+            const Lane& lane = lanes[index];
+            if (!lane.active) {
+                blocks[index] = idleBlock;
+            } else if (lane.block < lane.fullBlocks) {
+                blocks[index] = messages[lane.message] + lane.block * BLOCK_SIZE;
+            } else {
+                blocks[index] = lane.tail + (lane.block - lane.fullBlocks) * BLOCK_SIZE;
+            }
+        }
+
+        processBlock(state, blocks);
+
+        for (Size index = 0; index < laneCount; ++index) {
+            Lane& lane = lanes[index];
+            if (!lane.active || ++lane.block < lane.totalBlocks) {
+                continue;
+            }
+            Byte* digest = digests + lane.message * Sha256Batch::DIGEST_SIZE;
+            for (Size word = 0; word < 8; ++word) {
+                bits::storeBigEndian(digest + 4 * word, state[word * laneCount + index]);
+            }
+            refill(index);
+            active -= lane.active ? 0 : 1;
+        }
+    }
+}
+
+} // namespace
+
+void Sha256Batch::hash(const Byte* const* messages,
+                       const Size* sizes,
+                       const Size count,
+                       Byte* digests,
+                       const Implementation implementation) {
+    if (!isSupported(implementation)) {
+        throw Exception("SHA-256 batch: Implementation not supported on this CPU");
+    }
+    switch (implementation) {
+    case Implementation::Avx512:
+        hashLanes(messages, sizes, count, digests, Sha256MultiBuffer::AVX512_LANES,
+                  Sha256MultiBuffer::processBlockAvx512);
+        break;
+    case Implementation::Avx2:
+        hashLanes(messages, sizes, count, digests, Sha256MultiBuffer::AVX2_LANES,
+                  Sha256MultiBuffer::processBlockAvx2);
+        break;
+    default:
+        for (Size i = 0; i < count; ++i) {
+            Sha256 sha256;
+            sha256.update(messages[i], sizes[i]);
+            BufferSlice<Byte> digest(digests + i * DIGEST_SIZE, digests + (i + 1) * DIGEST_SIZE);
+            sha256.finalize(digest);
+        }
+        break;
+    }
+}
+
+bool Sha256Batch::isSupported(const Implementation implementation) {
+    switch (implementation) {
+    case Implementation::Avx512:
+        return Sha256MultiBuffer::isAvx512Supported();
+    case Implementation::Avx2:
+        return Sha256MultiBuffer::isAvx2Supported();
+    default:
+        return true;
+    }
+}
+
+Sha256Batch::Implementation Sha256Batch::getDefaultImplementation() {
+    if (isSupported(Implementation::Avx512)) {
+        return Implementation::Avx512;
+    }
+    return isSupported(Implementation::Avx2) ? Implementation::Avx2 : Implementation::Serial;
+}
+
+Size Sha256Batch::getLaneCount(const Implementation implementation) {
+    switch (implementation) {
+    case Implementation::Avx512:
+        return Sha256MultiBuffer::AVX512_LANES;
+    case Implementation::Avx2:
+        return Sha256MultiBuffer::AVX2_LANES;
+    default:
+        return 1;
+    }
+}
+
+} // namespace crypto
@@ -0,0 +1,114 @@
+#include "cpplibcrypto/common/Cpu.h"
+#include "cpplibcrypto/hash/Sha256MultiBuffer.h"
+#include "cpplibcrypto/hash/Sha2.h"
+
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CPPLIBCRYPTO_SHA256_AVX2
+#endif
+
+namespace crypto {
+
+#ifdef CPPLIBCRYPTO_SHA256_AVX2
+
+namespace {
+
+// The helpers are local so that no AVX2 code can end up in the inline functions shared with the rest of the
+// library
+
+template <int N>
+__m256i rotateRight(const __m256i v) {
+    return _mm256_or_si256(_mm256_srli_epi32(v, N), _mm256_slli_epi32(v, 32 - N));
+}
+
+__m256i xor3(const __m256i a, const __m256i b, const __m256i c) {
+    return _mm256_xor_si256(_mm256_xor_si256(a, b), c);
+}
+
+__m256i add3(const __m256i a, const __m256i b, const __m256i c) {
+    return _mm256_add_epi32(_mm256_add_epi32(a, b), c);
+}
+
+/// Gathers the big-endian message word t of every lane
+__m256i loadWord(const Byte* const* blocks, const Size t) {
+    alignas(32) Dword words[Sha256MultiBuffer::AVX2_LANES];
+    for (Size lane = 0; lane < Sha256MultiBuffer::AVX2_LANES; ++lane) {
+        Dword word;
+        std::memcpy(&word, blocks[lane] + 4 * t, sizeof(word));
+        words[lane] = __builtin_bswap32(word);
+    }
+    return _mm256_load_si256(reinterpret_cast<const __m256i*>(words));
+}
+
+} // namespace
+
+bool Sha256MultiBuffer::isAvx2Supported() {
+    return Cpu::hasAvx2();
+}
+
+void Sha256MultiBuffer::processBlockAvx2(Dword* state, const Byte* const* blocks) {
+    __m256i* rows = reinterpret_cast<__m256i*>(state);
+    __m256i a = _mm256_loadu_si256(rows + 0);
+    __m256i b = _mm256_loadu_si256(rows + 1);
+    __m256i c = _mm256_loadu_si256(rows + 2);
+    __m256i d = _mm256_loadu_si256(rows + 3);
+    __m256i e = _mm256_loadu_si256(rows + 4);
+    __m256i f = _mm256_loadu_si256(rows + 5);
+    __m256i g = _mm256_loadu_si256(rows + 6);
+    __m256i h = _mm256_loadu_si256(rows + 7);
+
+    // The message schedule only ever needs the last 16 words
+    __m256i W[16];
+    for (Size t = 0; t < 64; ++t) {
+        if (t < 16) {
+            W[t] = loadWord(blocks, t);
+        } else {
+            const __m256i w2 = W[(t - 2) & 15];
+            const __m256i w15 = W[(t - 15) & 15];
+            const __m256i sigma1 = xor3(rotateRight<17>(w2), rotateRight<19>(w2), _mm256_srli_epi32(w2, 10));
+            const __m256i sigma0 = xor3(rotateRight<7>(w15), rotateRight<18>(w15), _mm256_srli_epi32(w15, 3));
+            W[t & 15] = add3(W[t & 15], sigma1, _mm256_add_epi32(W[(t - 7) & 15], sigma0));
+        }
+
+        const __m256i bigSigma1 = xor3(rotateRight<6>(e), rotateRight<11>(e), rotateRight<25>(e));
+        const __m256i choose = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+        const __m256i k = _mm256_set1_epi32(int(sha::sha256K[t]));
+        const __m256i temp1 = add3(_mm256_add_epi32(h, bigSigma1), choose, _mm256_add_epi32(k, W[t & 15]));
+        const __m256i bigSigma0 = xor3(rotateRight<2>(a), rotateRight<13>(a), rotateRight<22>(a));
+        const __m256i majority =
+            xor3(_mm256_and_si256(a, b), _mm256_and_si256(a, c), _mm256_and_si256(b, c));
+        h = g;
+        g = f;
+        f = e;
+        e = _mm256_add_epi32(d, temp1);
+        d = c;
+        c = b;
+        b = a;
+        a = add3(temp1, bigSigma0, majority);
+    }
+
+    _mm256_storeu_si256(rows + 0, _mm256_add_epi32(_mm256_loadu_si256(rows + 0), a));
+    _mm256_storeu_si256(rows + 1, _mm256_add_epi32(_mm256_loadu_si256(rows + 1), b));
+    _mm256_storeu_si256(rows + 2, _mm256_add_epi32(_mm256_loadu_si256(rows + 2), c));
+    _mm256_storeu_si256(rows + 3, _mm256_add_epi32(_mm256_loadu_si256(rows + 3), d));
+    _mm256_storeu_si256(rows + 4, _mm256_add_epi32(_mm256_loadu_si256(rows + 4), e));
+    _mm256_storeu_si256(rows + 5, _mm256_add_epi32(_mm256_loadu_si256(rows + 5), f));
+    _mm256_storeu_si256(rows + 6, _mm256_add_epi32(_mm256_loadu_si256(rows + 6), g));
+    _mm256_storeu_si256(rows + 7, _mm256_add_epi32(_mm256_loadu_si256(rows + 7), h));
+}
+
+#else
+
+bool Sha256MultiBuffer::isAvx2Supported() {
+    return false;
+}
+
+void Sha256MultiBuffer::processBlockAvx2(Dword*, const Byte* const*) {
+    ASSERT(false);
+}
+
+#endif
+
+} // namespace crypto
@@ -0,0 +1,129 @@
+#include "cpplibcrypto/common/Cpu.h"
+#include "cpplibcrypto/hash/Sha256MultiBuffer.h"
+#include "cpplibcrypto/hash/Sha2.h"
+
+#include <cstring>
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+#define CPPLIBCRYPTO_SHA256_AVX512
+#endif
+
+namespace crypto {
+
+#ifdef CPPLIBCRYPTO_SHA256_AVX512
+
+namespace {
+
+// The helpers are local so that no AVX-512 code can end up in the inline functions shared with the rest of
+// the library
+
+// Truth tables for VPTERNLOGD, bit (a << 2 | b << 1 | c) of the immediate holds the result
+constexpr int TERNARY_XOR = 0x96;
+constexpr int TERNARY_CHOOSE = 0xca;
+constexpr int TERNARY_MAJORITY = 0xe8;
+
+// The plain shift and rotate intrinsics of GCC pass an undefined merge source to the masked builtins, for
+// which GCC 12 warns about an uninitialized variable. The zero-masking forms with all the lanes enabled
+// compile to the same instructions.
+constexpr __mmask16 ALL_LANES = 0xffff;
+
+template <int N>
+__m512i rotateRight(const __m512i v) {
+    return _mm512_maskz_ror_epi32(ALL_LANES, v, N);
+}
+
+template <int N>
+__m512i shiftRight(const __m512i v) {
+    return _mm512_maskz_srli_epi32(ALL_LANES, v, N);
+}
+
+__m512i xor3(const __m512i a, const __m512i b, const __m512i c) {
+    return _mm512_ternarylogic_epi32(a, b, c, TERNARY_XOR);
+}
+
+__m512i add3(const __m512i a, const __m512i b, const __m512i c) {
+    return _mm512_add_epi32(_mm512_add_epi32(a, b), c);
+}
+
+/// Gathers the big-endian message word t of every lane
+__m512i loadWord(const Byte* const* blocks, const Size t) {
+    // AVX-512F alone has no byte shuffle, the words are byte swapped on the way in
+    alignas(64) Dword words[Sha256MultiBuffer::AVX512_LANES];
+    for (Size lane = 0; lane < Sha256MultiBuffer::AVX512_LANES; ++lane) {
+        Dword word;
+        std::memcpy(&word, blocks[lane] + 4 * t, sizeof(word));
+        words[lane] = __builtin_bswap32(word);
+    }
+    return _mm512_load_si512(words);
+}
+
+} // namespace
+
+bool Sha256MultiBuffer::isAvx512Supported() {
+    return Cpu::hasAvx512();
+}
+
+void Sha256MultiBuffer::processBlockAvx512(Dword* state, const Byte* const* blocks) {
+    __m512i* rows = reinterpret_cast<__m512i*>(state);
+    __m512i a = _mm512_loadu_si512(rows + 0);
+    __m512i b = _mm512_loadu_si512(rows + 1);
+    __m512i c = _mm512_loadu_si512(rows + 2);
+    __m512i d = _mm512_loadu_si512(rows + 3);
+    __m512i e = _mm512_loadu_si512(rows + 4);
+    __m512i f = _mm512_loadu_si512(rows + 5);
+    __m512i g = _mm512_loadu_si512(rows + 6);
+    __m512i h = _mm512_loadu_si512(rows + 7);
+
+    // The message schedule only ever needs the last 16 words
+    __m512i W[16];
+    for (Size t = 0; t < 64; ++t) {
+        if (t < 16) {
+            W[t] = loadWord(blocks, t);
+        } else {
+            const __m512i w2 = W[(t - 2) & 15];
+            const __m512i w15 = W[(t - 15) & 15];
+            const __m512i sigma1 = xor3(rotateRight<17>(w2), rotateRight<19>(w2), shiftRight<10>(w2));
+            const __m512i sigma0 = xor3(rotateRight<7>(w15), rotateRight<18>(w15), shiftRight<3>(w15));
+            W[t & 15] = add3(W[t & 15], sigma1, _mm512_add_epi32(W[(t - 7) & 15], sigma0));
+        }
+
+        const __m512i bigSigma1 = xor3(rotateRight<6>(e), rotateRight<11>(e), rotateRight<25>(e));
+        const __m512i choose = _mm512_ternarylogic_epi32(e, f, g, TERNARY_CHOOSE);
+        const __m512i k = _mm512_set1_epi32(int(sha::sha256K[t]));
+        const __m512i temp1 = add3(_mm512_add_epi32(h, bigSigma1), choose, _mm512_add_epi32(k, W[t & 15]));
+        const __m512i bigSigma0 = xor3(rotateRight<2>(a), rotateRight<13>(a), rotateRight<22>(a));
+        const __m512i majority = _mm512_ternarylogic_epi32(a, b, c, TERNARY_MAJORITY);
+        h = g;
+        g = f;
+        f = e;
+        e = _mm512_add_epi32(d, temp1);
+        d = c;
+        c = b;
+        b = a;
+        a = add3(temp1, bigSigma0, majority);
+    }
+
+    _mm512_storeu_si512(rows + 0, _mm512_add_epi32(_mm512_loadu_si512(rows + 0), a));
+    _mm512_storeu_si512(rows + 1, _mm512_add_epi32(_mm512_loadu_si512(rows + 1), b));
+    _mm512_storeu_si512(rows + 2, _mm512_add_epi32(_mm512_loadu_si512(rows + 2), c));
+    _mm512_storeu_si512(rows + 3, _mm512_add_epi32(_mm512_loadu_si512(rows + 3), d));
+    _mm512_storeu_si512(rows + 4, _mm512_add_epi32(_mm512_loadu_si512(rows + 4), e));
+    _mm512_storeu_si512(rows + 5, _mm512_add_epi32(_mm512_loadu_si512(rows + 5), f));
+    _mm512_storeu_si512(rows + 6, _mm512_add_epi32(_mm512_loadu_si512(rows + 6), g));
+    _mm512_storeu_si512(rows + 7, _mm512_add_epi32(_mm512_loadu_si512(rows + 7), h));
+}
+
+#else
+
+bool Sha256MultiBuffer::isAvx512Supported() {
+    return false;
+}
+
+void Sha256MultiBuffer::processBlockAvx512(Dword*, const Byte* const*) {
+    ASSERT(false);
+}
+
+#endif
+
+} // namespace crypto
@@ -0,0 +1,131 @@
+#include "cpplibcrypto/hash/Sha512Avx2.h"
+#include "cpplibcrypto/common/Cpu.h"
+#include "cpplibcrypto/hash/Sha2.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CPPLIBCRYPTO_SHA512_AVX2
+#endif
+
+namespace crypto {
+
+#ifdef CPPLIBCRYPTO_SHA512_AVX2
+
+namespace {
+
+// This translation unit is compiled with -mavx2, the helpers are local so that no AVX2 code can end up in
+// the inline functions shared with the rest of the library
+
+template <int N>
+__m256i rotateRight(const __m256i v) {
+    return _mm256_or_si256(_mm256_srli_epi64(v, N), _mm256_slli_epi64(v, 64 - N));
+}
+
+__m256i sigma0(const __m256i v) {
+    return _mm256_xor_si256(_mm256_xor_si256(rotateRight<1>(v), rotateRight<8>(v)), _mm256_srli_epi64(v, 7));
+}
+
+__m256i sigma1(const __m256i v) {
+    return _mm256_xor_si256(_mm256_xor_si256(rotateRight<19>(v), rotateRight<61>(v)),
+                            _mm256_srli_epi64(v, 6));
+}
+
+template <int N>
+Qword rotateRight(const Qword v) {
+    return (v >> N) | (v << (64 - N));
+}
+
+/// Computes W[t] + K[t] for all the 80 rounds of one block
+void messageSchedule(const Byte* in, Qword* wk) {
+    // Reverses the bytes of each Qword
+    const __m256i byteSwap = _mm256_set_epi64x(
+        0x08090a0b0c0d0e0fULL, 0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL, 0x0001020304050607ULL);
+
+    alignas(32) Qword W[80];
+    for (Size i = 0; i < 4; ++i) {
+        const __m256i words = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in) + i);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(W) + i, _mm256_shuffle_epi8(words, byteSwap));
+    }
+
+    for (Size t = 16; t < 80; t += 4) {
+        // W[t-16] + sigma0(W[t-15]) + W[t-7] is available for all four words, sigma1(W[t-2]) only for the
+        // first two as the other two depend on W[t] and W[t+1] computed here
+        const __m256i w16 = _mm256_load_si256(reinterpret_cast<const __m256i*>(W + t - 16));
+        const __m256i w15 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(W + t - 15));
+        const __m256i w7 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(W + t - 7));
+        __m256i words = _mm256_add_epi64(_mm256_add_epi64(w16, sigma0(w15)), w7);
+        const __m128i previous = _mm_load_si128(reinterpret_cast<const __m128i*>(W + t - 2));
+        words = _mm256_add_epi64(words, sigma1(_mm256_zextsi128_si256(previous)));
+
+        const __m256i current =
+            _mm256_blend_epi32(_mm256_setzero_si256(), _mm256_permute4x64_epi64(words, 0x44), 0xf0);
+        words = _mm256_add_epi64(words, sigma1(current));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(W + t), words);
+    }
+
+    for (Size t = 0; t < 80; t += 4) {
+        const __m256i k = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sha::sha512K + t));
+        const __m256i w = _mm256_load_si256(reinterpret_cast<const __m256i*>(W + t));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(wk + t), _mm256_add_epi64(w, k));
+    }
+}
+
+} // namespace
+
+bool Sha512Avx2::isSupported() {
+    return Cpu::hasAvx2();
+}
+
+void Sha512Avx2::processBlocks(Qword* state, const Byte* in, Size nBlocks) {
+    Qword wk[80];
+    for (; nBlocks > 0; --nBlocks, in += 128) {
+        messageSchedule(in, wk);
+
+        Qword A = state[0];
+        Qword B = state[1];
+        Qword C = state[2];
+        Qword D = state[3];
+        Qword E = state[4];
+        Qword F = state[5];
+        Qword G = state[6];
+        Qword H = state[7];
+
+        for (Size t = 0; t < 80; ++t) {
+            const Qword bigSigma1 = rotateRight<14>(E) ^ rotateRight<18>(E) ^ rotateRight<41>(E);
+            const Qword bigSigma0 = rotateRight<28>(A) ^ rotateRight<34>(A) ^ rotateRight<39>(A);
+            const Qword temp1 = H + bigSigma1 + ((E & F) ^ (~E & G)) + wk[t];
+            const Qword temp2 = bigSigma0 + ((A & B) ^ (A & C) ^ (B & C));
+            H = G;
+            G = F;
+            F = E;
+            E = D + temp1;
+            D = C;
+            C = B;
+            B = A;
+            A = temp1 + temp2;
+        }
+
+        state[0] += A;
+        state[1] += B;
+        state[2] += C;
+        state[3] += D;
+        state[4] += E;
+        state[5] += F;
+        state[6] += G;
+        state[7] += H;
+    }
+}
+
+#else
+
+bool Sha512Avx2::isSupported() {
+    return false;
+}
+
+void Sha512Avx2::processBlocks(Qword*, const Byte*, Size) {
+    ASSERT(false);
+}
+
+#endif
+
+} // namespace crypto
@@ -0,0 +1,143 @@
+#include "cpplibcrypto/hash/ShaNi.h"
+#include "cpplibcrypto/common/Cpu.h"
+#include "cpplibcrypto/hash/Sha2.h"
+
+#if defined(__SHA__) && defined(__SSE4_1__)
+#include <immintrin.h>
+#define CPPLIBCRYPTO_SHA_NI
+#endif
+
+namespace crypto {
+
+#ifdef CPPLIBCRYPTO_SHA_NI
+
+bool ShaNi::isSupported() {
+    return Cpu::hasSha();
+}
+
+void ShaNi::sha1ProcessBlocks(Dword* state, const Byte* in, Size nBlocks) {
+    // Converts the big-endian message words and reverses their order, SHA1RNDS4 expects W0 in the top lane
+    const __m128i byteSwap = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0x1b);
+    // E is kept in the top lane, it alternates between two registers as SHA1NEXTE derives it from A
+    __m128i e[2] = { _mm_set_epi32(int(state[4]), 0, 0, 0), _mm_setzero_si128() };
+
+    for (; nBlocks > 0; --nBlocks, in += 64) {
+        const __m128i abcdSaved = abcd;
+        const __m128i eSaved = e[0];
+
+        __m128i msg[4];
+        for (Size i = 0; i < 4; ++i) {
+            msg[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in) + i), byteSwap);
+        }
+
+        // 20 groups of 4 rounds, the round function changes every 5 groups. The message schedule keeps 16
+        // words in msg[] and computes the next 4 words while the rounds of the current ones are in progress.
+        for (Size group = 0; group < 20; ++group) {
+            const __m128i current = msg[group % 4];
+            __m128i& roundE = e[group % 2];
+            roundE = group == 0 ? _mm_add_epi32(roundE, current) : _mm_sha1nexte_epu32(roundE, current);
+            e[(group + 1) % 2] = abcd;
+            switch (group / 5) {
+            case 0:
+                abcd = _mm_sha1rnds4_epu32(abcd, roundE, 0);
+                break;
+            case 1:
+                abcd = _mm_sha1rnds4_epu32(abcd, roundE, 1);
+                break;
+            case 2:
+                abcd = _mm_sha1rnds4_epu32(abcd, roundE, 2);
+                break;
+            default:
+                abcd = _mm_sha1rnds4_epu32(abcd, roundE, 3);
+                break;
+            }
+
+            if (group >= 3 && group <= 18) {
+                msg[(group + 1) % 4] = _mm_sha1msg2_epu32(msg[(group + 1) % 4], current);
+            }
+            if (group >= 2 && group <= 17) {
+                msg[(group + 2) % 4] = _mm_xor_si128(msg[(group + 2) % 4], current);
+            }
+            if (group >= 1 && group <= 16) {
+                msg[(group + 3) % 4] = _mm_sha1msg1_epu32(msg[(group + 3) % 4], current);
+            }
+        }
+
+        e[0] = _mm_sha1nexte_epu32(e[0], eSaved);
+        abcd = _mm_add_epi32(abcd, abcdSaved);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi32(abcd, 0x1b));
+    state[4] = Dword(_mm_extract_epi32(e[0], 3));
+}
+
+void ShaNi::sha256ProcessBlocks(Dword* state, const Byte* in, Size nBlocks) {
+    // Converts the big-endian message words
+    const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // SHA256RNDS2 expects the state as ABEF and CDGH
+    const __m128i dcba = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0xb1);
+    const __m128i efgh =
+        _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4)), 0x1b);
+    __m128i abef = _mm_alignr_epi8(dcba, efgh, 8);
+    __m128i cdgh = _mm_blend_epi16(efgh, dcba, 0xf0);
+
+    for (; nBlocks > 0; --nBlocks, in += 64) {
+        const __m128i abefSaved = abef;
+        const __m128i cdghSaved = cdgh;
+
+        __m128i msg[4];
+        for (Size i = 0; i < 4; ++i) {
+            msg[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in) + i), byteSwap);
+        }
+
+        // 16 groups of 4 rounds, the message schedule keeps 16 words in msg[] and computes the next 4 words
+        // while the rounds of the current ones are in progress
+        for (Size group = 0; group < 16; ++group) {
+            const __m128i current = msg[group % 4];
+            const __m128i k = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sha::sha256K + 4 * group));
+            __m128i wk = _mm_add_epi32(current, k);
+            cdgh = _mm_sha256rnds2_epu32(cdgh, abef, wk);
+            wk = _mm_shuffle_epi32(wk, 0x0e);
+            abef = _mm_sha256rnds2_epu32(abef, cdgh, wk);
+
+            const __m128i previous = msg[(group + 3) % 4];
+            if (group >= 3 && group <= 14) {
+                __m128i& next = msg[(group + 1) % 4];
+                next = _mm_add_epi32(next, _mm_alignr_epi8(current, previous, 4));
+                next = _mm_sha256msg2_epu32(next, current);
+            }
+            if (group >= 1 && group <= 12) {
+                msg[(group + 3) % 4] = _mm_sha256msg1_epu32(previous, current);
+            }
+        }
+
+        abef = _mm_add_epi32(abef, abefSaved);
+        cdgh = _mm_add_epi32(cdgh, cdghSaved);
+    }
+
+    const __m128i feba = _mm_shuffle_epi32(abef, 0x1b);
+    const __m128i dchg = _mm_shuffle_epi32(cdgh, 0xb1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_blend_epi16(feba, dchg, 0xf0));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+#else
+
+bool ShaNi::isSupported() {
+    return false;
+}
+
+void ShaNi::sha1ProcessBlocks(Dword*, const Byte*, Size) {
+    ASSERT(false);
+}
+
+void ShaNi::sha256ProcessBlocks(Dword*, const Byte*, Size) {
+    ASSERT(false);
+}
+
+#endif
+
+} // namespace crypto
@@ -0,0 +1,646 @@
+#include "cpplibcrypto/io/AsyncFileStream.h"
+#include "cpplibcrypto/common/Exception.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define CPPLIBCRYPTO_IO_URING
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace crypto {
+
+#ifdef CPPLIBCRYPTO_IO_URING
+
+namespace {
+
+constexpr Size PAGE_SIZE = 4096;
+
+Size roundUp(const Size value, const Size alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+int ioUringSetup(const unsigned entries, io_uring_params* params) {
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int ioUringEnter(const int fd, const unsigned toSubmit, const unsigned minComplete, const unsigned flags) {
+    return static_cast<int>(::syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+int ioUringRegister(const int fd, const unsigned opcode, const void* arg, const unsigned count) {
+    return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, count));
+}
+
+/// Opens the file, falling back to the page cache if the file system doesn't support direct I/O
+int openFile(const String& fileName, const int flags, bool& direct) {
+    if (direct) {
+        const int fd = ::open(fileName.c_str(), flags | O_DIRECT, 0644);
+        if (fd >= 0 || errno != EINVAL) {
+            return fd;
+        }
+        direct = false;
+    }
+    return ::open(fileName.c_str(), flags, 0644);
+}
+
+} // namespace
+
+/// Minimal io_uring submission/completion queue pair with a set of registered buffers
+///
+/// Talks to the kernel through the raw system calls, no liburing is needed. Only used by one thread at a
+/// time, the memory barriers are there for the kernel side of the rings.
+class IoUring final {
+public:
+    enum class Operation { READ, WRITE };
+
+    struct Completion {
+        Qword userData;
+        int result;
+    };
+
+    /// Sets up a ring for the given number of requests and allocates the buffers
+    /// \throws Exception in case io_uring is not supported or the memory couldn't be allocated
+    IoUring(const Size bufferCount, const Size bufferSize)
+        : mBufferCount(bufferCount)
+        , mBufferSize(bufferSize) {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        mFd = ioUringSetup(static_cast<unsigned>(bufferCount), &params);
+        if (mFd < 0) {
+            throw Exception("io_uring: Not supported by the kernel");
+        }
+
+        mSqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        mCqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (singleMmap) {
+            mSqRingSize = mCqRingSize = std::max(mSqRingSize, mCqRingSize);
+        }
+        mSqRing = map(mSqRingSize, IORING_OFF_SQ_RING);
+        mCqRing = singleMmap ? mSqRing : map(mCqRingSize, IORING_OFF_CQ_RING);
+        mSqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        mSqes = static_cast<io_uring_sqe*>(map(mSqesSize, IORING_OFF_SQES));
+
+        mSqTail = ringField(mSqRing, params.sq_off.tail);
+        mSqMask = *ringField(mSqRing, params.sq_off.ring_mask);
+        mSqArray = ringField(mSqRing, params.sq_off.array);
+        mCqHead = ringField(mCqRing, params.cq_off.head);
+        mCqTail = ringField(mCqRing, params.cq_off.tail);
+        mCqMask = *ringField(mCqRing, params.cq_off.ring_mask);
+        mCqes = reinterpret_cast<io_uring_cqe*>(static_cast<Byte*>(mCqRing) + params.cq_off.cqes);
+
+        void* buffers = nullptr;
+        if (::posix_memalign(&buffers, PAGE_SIZE, bufferCount * bufferSize) != 0) {
+            release();
+            throw Exception("io_uring: Could not allocate the buffers");
+        }
+        mBuffers = static_cast<Byte*>(buffers);
+
+        // Registered buffers save the kernel pinning the pages on every request. The registration counts
+        // against the locked memory limit, the requests work with plain buffers as well if it fails.
+        std::unique_ptr<iovec[]> iovecs(new (std::nothrow) iovec[bufferCount]);
+        if (!iovecs) {
+            release();
+            throw Exception("io_uring: Could not allocate the buffers");
+        }
+        for (Size i = 0; i < bufferCount; ++i) {
+            iovecs[i].iov_base = mBuffers + i * bufferSize;
+            iovecs[i].iov_len = bufferSize;
+        }
+        const unsigned count = static_cast<unsigned>(bufferCount);
+        mFixedBuffers = ioUringRegister(mFd, IORING_REGISTER_BUFFERS, iovecs.get(), count) == 0;
+    }
+
+    ~IoUring() noexcept { release(); }
+
+    /// Returns the registered buffer with the given index
+    Byte* getBuffer(const Size index) const { return mBuffers + index * mBufferSize; }
+
+    Size getBufferSize() const { return mBufferSize; }
+
+    /// Queues a request, it is sent to the kernel by the next \ref submit() or \ref wait()
+    /// \param bufferIndex The registered buffer which \p address points into
+    void queue(const Operation operation,
+               const int fd,
+               const Size bufferIndex,
+               Byte* address,
+               const Size size,
+               const Size offset,
+               const Qword userData) {
+        const unsigned tail = *mSqTail;
+        const unsigned index = tail & mSqMask;
+        io_uring_sqe& sqe = mSqes[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        if (operation == Operation::READ) {
+            sqe.opcode = mFixedBuffers ? IORING_OP_READ_FIXED : IORING_OP_READ;
+        } else {
+            sqe.opcode = mFixedBuffers ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+        }
+        sqe.fd = fd;
+        sqe.addr = reinterpret_cast<Qword>(address);
+        sqe.len = static_cast<unsigned>(size);
+        sqe.off = offset;
+        sqe.buf_index = static_cast<decltype(sqe.buf_index)>(bufferIndex);
+        sqe.user_data = userData;
+        mSqArray[index] = index;
+        __atomic_store_n(mSqTail, tail + 1, __ATOMIC_RELEASE);
+        ++mQueued;
+    }
+
+    /// Sends the queued requests to the kernel without waiting for them
+    void submit() {
+        if (mQueued != 0) {
+            enter(0);
+        }
+    }
+
+    /// Sends the queued requests to the kernel and returns the first completion, waiting for it if needed
+    Completion wait() {
+        while (true) {
+            const unsigned head = *mCqHead;
+            if (head != __atomic_load_n(mCqTail, __ATOMIC_ACQUIRE)) {
+                const io_uring_cqe& cqe = mCqes[head & mCqMask];
+                const Completion completion{ cqe.user_data, cqe.res };
+                __atomic_store_n(mCqHead, head + 1, __ATOMIC_RELEASE);
+                if (mQueued != 0) {
+                    enter(0);
+                }
+                return completion;
+            }
+            enter(1);
+        }
+    }
+
+private:
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    void enter(const unsigned minComplete) {
+        const unsigned flags = minComplete != 0 ? IORING_ENTER_GETEVENTS : 0;
+        while (true) {
+            const int submitted = ioUringEnter(mFd, mQueued, minComplete, flags);
+            if (submitted >= 0) {
+                mQueued -= static_cast<unsigned>(submitted);
+                return;
+            }
+            if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+                throw Exception("io_uring: Failed to submit the requests");
+            }
+        }
+    }
+
+    void* map(const Size size, const Qword offset) {
+        void* ring = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mFd, offset);
+        if (ring == MAP_FAILED) {
+            release();
+            throw Exception("io_uring: Could not map the rings");
+        }
+        return ring;
+    }
+
+    static unsigned* ringField(void* ring, const unsigned offset) {
+        return reinterpret_cast<unsigned*>(static_cast<Byte*>(ring) + offset);
+    }
+
+    void release() noexcept {
+        if (mBuffers != nullptr) {
+            // The buffers held the plaintext of whatever was being encrypted
+            volatile Byte* buffers = mBuffers;
+            for (Size i = 0; i < mBufferCount * mBufferSize; ++i) {
+                buffers[i] = 0;
+            }
+            std::free(mBuffers);
+            mBuffers = nullptr;
+        }
+        if (mSqes != nullptr) {
+            ::munmap(mSqes, mSqesSize);
+            mSqes = nullptr;
+        }
+        if (mCqRing != nullptr && mCqRing != mSqRing) {
+            ::munmap(mCqRing, mCqRingSize);
+        }
+        mCqRing = nullptr;
+        if (mSqRing != nullptr) {
+            ::munmap(mSqRing, mSqRingSize);
+            mSqRing = nullptr;
+        }
+        if (mFd >= 0) {
+            ::close(mFd);
+            mFd = -1;
+        }
+    }
+
+    int mFd = -1;
+    Size mBufferCount;
+    Size mBufferSize;
+    Byte* mBuffers = nullptr;
+    bool mFixedBuffers = false;
+    unsigned mQueued = 0;
+
+    void* mSqRing = nullptr;
+    Size mSqRingSize = 0;
+    void* mCqRing = nullptr;
+    Size mCqRingSize = 0;
+    io_uring_sqe* mSqes = nullptr;
+    Size mSqesSize = 0;
+
+    unsigned* mSqTail = nullptr;
+    unsigned mSqMask = 0;
+    unsigned* mSqArray = nullptr;
+    unsigned* mCqHead = nullptr;
+    unsigned* mCqTail = nullptr;
+    unsigned mCqMask = 0;
+    io_uring_cqe* mCqes = nullptr;
+};
+
+bool AsyncFileInputStream::isSupported() {
+    static const bool supported = [] {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        const int fd = ioUringSetup(1, &params);
+        if (fd < 0) {
+            return false;
+        }
+        ::close(fd);
+        return true;
+    }();
+    return supported;
+}
+
+AsyncFileInputStream::AsyncFileInputStream(String fileName, const AsyncFileOptions& options)
+    : mFileName(std::move(fileName))
+    , mDirect(options.direct) {
+    ASSERT(options.bufferCount > 0);
+    mFd = openFile(mFileName, O_RDONLY | O_CLOEXEC, mDirect);
+    if (mFd < 0) {
+        throw Exception("Could not open the file specified (" + mFileName + ')');
+    }
+    try {
+        struct stat info;
+        if (::fstat(mFd, &info) != 0) {
+            throw Exception("Could not get the size of the file specified (" + mFileName + ')');
+        }
+        // Pipes, devices and /proc files report a size of 0 and would silently read as empty
+        if (!S_ISREG(info.st_mode)) {
+            throw Exception("The file specified is not a regular file (" + mFileName + ')');
+        }
+        mFileSize = static_cast<Size>(info.st_size);
+        mSlotCount = options.bufferCount;
+        mSlots.reset(new Slot[mSlotCount]);
+        mRing.reset(new IoUring(mSlotCount, roundUp(std::max<Size>(options.bufferSize, 1), PAGE_SIZE)));
+        for (Size i = 0; i < mSlotCount; ++i) {
+            requestNext(i);
+        }
+        mRing->submit();
+    } catch (...) {
+        mRing.reset();
+        ::close(mFd);
+        throw;
+    }
+}
+
+AsyncFileInputStream::~AsyncFileInputStream() noexcept {
+    try {
+        if (isOpen()) {
+            close();
+        }
+    } catch (...) {
+    }
+}
+
+Size AsyncFileInputStream::read(void* output, const Size count) {
+    ASSERT(output != nullptr || count == 0);
+    Byte* out = static_cast<Byte*>(output);
+    Size done = 0;
+    while (done < count && !eof()) {
+        advance();
+        const Slot& slot = mSlots[mHead];
+        const Size size = std::min(count - done, slot.filled - mHeadConsumed);
+        std::memcpy(out + done, mRing->getBuffer(mHead) + mHeadConsumed, size);
+        mHeadConsumed += size;
+        mPosition += size;
+        done += size;
+    }
+    return done;
+}
+
+BufferSlice<const Byte> AsyncFileInputStream::next() {
+    if (eof()) {
+        return BufferSlice<const Byte>(nullptr, nullptr);
+    }
+    advance();
+    const Slot& slot = mSlots[mHead];
+    const Byte* window = mRing->getBuffer(mHead) + mHeadConsumed;
+    const Size size = slot.filled - mHeadConsumed;
+    mHeadConsumed = slot.filled;
+    mPosition += size;
+    return BufferSlice<const Byte>(window, window + size);
+}
+
+bool AsyncFileInputStream::eof() const {
+    ASSERT(isOpen());
+    return mPosition >= mFileSize;
+}
+
+void AsyncFileInputStream::close() {
+    ASSERT(isOpen());
+    // The kernel may still be writing to the buffers, they can only be released once the reads complete
+    auto pending = [this] {
+        return std::any_of(mSlots.get(), mSlots.get() + mSlotCount, [](const Slot& slot) {
+            return slot.state == SlotState::PENDING;
+        });
+    };
+    while (pending()) {
+        const IoUring::Completion completion = mRing->wait();
+        mSlots[completion.userData].state = SlotState::IDLE;
+    }
+    mRing.reset();
+    const int result = ::close(mFd);
+    mFd = -1;
+    if (result != 0) {
+        throw Exception("Failed to close file (" + mFileName + ')');
+    }
+}
+
+void AsyncFileInputStream::requestNext(const Size index) {
+    Slot& slot = mSlots[index];
+    if (mNextOffset >= mFileSize) {
+        slot.state = SlotState::IDLE;
+        return;
+    }
+    slot.state = SlotState::PENDING;
+    slot.offset = mNextOffset;
+    slot.expected = std::min(mFileSize - mNextOffset, mRing->getBufferSize());
+    slot.filled = 0;
+    mNextOffset += slot.expected;
+    // The whole buffer is requested, direct I/O needs the size aligned even for the last part of the file
+    mRing->queue(IoUring::Operation::READ,
+                 mFd,
+                 index,
+                 mRing->getBuffer(index),
+                 mRing->getBufferSize(),
+                 slot.offset,
+                 index);
+}
+
+void AsyncFileInputStream::advance() {
+    if (mHeadConsumed == mSlots[mHead].filled && mSlots[mHead].state == SlotState::READY) {
+        requestNext(mHead);
+        mRing->submit();
+        mHead = (mHead + 1) % mSlotCount;
+        mHeadConsumed = 0;
+    }
+    while (mSlots[mHead].state == SlotState::PENDING) {
+        waitForCompletion();
+    }
+    if (mSlots[mHead].state != SlotState::READY || mSlots[mHead].filled == 0) {
+        throw Exception("Error reading bytes from file (" + mFileName + ')');
+    }
+}
+
+void AsyncFileInputStream::waitForCompletion() {
+    const IoUring::Completion completion = mRing->wait();
+    const Size index = completion.userData;
+    Slot& slot = mSlots[index];
+    if (completion.result < 0) {
+        slot.state = SlotState::IDLE;
+        throw Exception("Error reading bytes from file (" + mFileName + ')');
+    }
+    slot.filled += static_cast<Size>(completion.result);
+    if (completion.result == 0 || slot.filled >= slot.expected) {
+        // Nothing more to read means the file has been truncated in the meantime
+        slot.filled = std::min(slot.filled, slot.expected);
+        slot.state = SlotState::READY;
+        return;
+    }
+    // Short read, ask for the rest. Direct I/O needs the offset and the size aligned, so the rest is read
+    // from the last aligned position, up to the end of the buffer as the first request does.
+    Size resume = slot.filled;
+    Size size = slot.expected - slot.filled;
+    if (mDirect) {
+        resume -= resume % PAGE_SIZE;
+        size = mRing->getBufferSize() - resume;
+        slot.filled = resume;
+    }
+    mRing->queue(IoUring::Operation::READ,
+                 mFd,
+                 index,
+                 mRing->getBuffer(index) + resume,
+                 size,
+                 slot.offset + resume,
+                 index);
+    mRing->submit();
+}
+
+AsyncFileOutputStream::AsyncFileOutputStream(String fileName,
+                                             const OpenMode mode,
+                                             const AsyncFileOptions& options)
+    : mFileName(std::move(fileName))
+    , mDirect(options.direct) {
+    ASSERT(options.bufferCount > 0);
+    const int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (mode == OpenMode::OVERWRITE ? O_TRUNC : 0);
+    mFd = openFile(mFileName, flags, mDirect);
+    if (mFd < 0) {
+        throw Exception("Could not open the file specified (" + mFileName + ')');
+    }
+    try {
+        if (mode == OpenMode::APPEND) {
+            // The writes go to explicit offsets, starting at the current end of the file
+            struct stat info;
+            if (::fstat(mFd, &info) != 0) {
+                throw Exception("Could not get the size of the file specified (" + mFileName + ')');
+            }
+            mOffset = static_cast<Size>(info.st_size);
+            if (mDirect && mOffset % PAGE_SIZE != 0) {
+                ::fcntl(mFd, F_SETFL, ::fcntl(mFd, F_GETFL) & ~O_DIRECT);
+                mDirect = false;
+            }
+        }
+        mSlotCount = options.bufferCount;
+        mSlots.reset(new Slot[mSlotCount]);
+        mRing.reset(new IoUring(mSlotCount, roundUp(std::max<Size>(options.bufferSize, 1), PAGE_SIZE)));
+    } catch (...) {
+        mRing.reset();
+        ::close(mFd);
+        throw;
+    }
+}
+
+AsyncFileOutputStream::~AsyncFileOutputStream() noexcept {
+    try {
+        if (isOpen()) {
+            close();
+        }
+    } catch (...) {
+    }
+}
+
+void AsyncFileOutputStream::write(const void* source, const Size count) {
+    ASSERT(isOpen());
+    ASSERT(source != nullptr || count == 0);
+    const Byte* in = static_cast<const Byte*>(source);
+    const Size bufferSize = mRing->getBufferSize();
+    Size done = 0;
+    while (done < count) {
+        while (mSlots[mCurrent].state == SlotState::PENDING) {
+            waitForCompletion();
+        }
+        Slot& slot = mSlots[mCurrent];
+        const Size size = std::min(count - done, bufferSize - slot.size);
+        std::memcpy(mRing->getBuffer(mCurrent) + slot.size, in + done, size);
+        slot.size += size;
+        done += size;
+        if (slot.size == bufferSize) {
+            submitCurrent();
+        }
+    }
+}
+
+void AsyncFileOutputStream::flush() {
+    ASSERT(isOpen());
+    // Direct I/O can't write the partial buffer yet, the next write would have to start at unaligned offset
+    if (!mDirect && mSlots[mCurrent].size != 0) {
+        submitCurrent();
+    }
+    while (mPending != 0) {
+        waitForCompletion();
+    }
+}
+
+void AsyncFileOutputStream::close() {
+    ASSERT(isOpen());
+    flush();
+    const Size tail = mSlots[mCurrent].size;
+    if (tail != 0) {
+        // Only with direct I/O, write the last block padded with zeros and cut the file back to its size
+        const Size size = mOffset + tail;
+        const Size padded = roundUp(tail, PAGE_SIZE);
+        std::memset(mRing->getBuffer(mCurrent) + tail, 0, padded - tail);
+        mSlots[mCurrent].size = padded;
+        submitCurrent();
+        while (mPending != 0) {
+            waitForCompletion();
+        }
+        if (::ftruncate(mFd, static_cast<off_t>(size)) != 0) {
+            throw Exception("Could not write to the file specified (" + mFileName + ')');
+        }
+    }
+    mRing.reset();
+    const int result = ::close(mFd);
+    mFd = -1;
+    if (result != 0) {
+        throw Exception("Failed to close file (" + mFileName + ')');
+    }
+}
+
+void AsyncFileOutputStream::submitCurrent() {
+    Slot& slot = mSlots[mCurrent];
+    slot.state = SlotState::PENDING;
+    slot.offset = mOffset;
+    slot.written = 0;
+    mOffset += slot.size;
+    ++mPending;
+    requestWrite(mCurrent);
+    mCurrent = (mCurrent + 1) % mSlotCount;
+}
+
+void AsyncFileOutputStream::requestWrite(const Size index) {
+    Slot& slot = mSlots[index];
+    mRing->queue(IoUring::Operation::WRITE,
+                 mFd,
+                 index,
+                 mRing->getBuffer(index) + slot.written,
+                 slot.size - slot.written,
+                 slot.offset + slot.written,
+                 index);
+    mRing->submit();
+}
+
+void AsyncFileOutputStream::waitForCompletion() {
+    const IoUring::Completion completion = mRing->wait();
+    const Size index = completion.userData;
+    Slot& slot = mSlots[index];
+    if (completion.result <= 0) {
+        // The data of this buffer is lost, the stream can't continue
+        slot.state = SlotState::FILLING;
+        slot.size = 0;
+        --mPending;
+        throw Exception("Could not write to the file specified (" + mFileName + ')');
+    }
+    slot.written += static_cast<Size>(completion.result);
+    if (slot.written < slot.size) {
+        requestWrite(index);
+        return;
+    }
+    slot.state = SlotState::FILLING;
+    slot.size = 0;
+    --mPending;
+}
+
+#else
+
+class IoUring final {};
+
+bool AsyncFileInputStream::isSupported() {
+    return false;
+}
+
+AsyncFileInputStream::AsyncFileInputStream(String fileName, const AsyncFileOptions&)
+    : mFileName(std::move(fileName)) {
+    throw Exception("io_uring: Not supported on this platform");
+}
+
+AsyncFileInputStream::~AsyncFileInputStream() noexcept = default;
+
+Size AsyncFileInputStream::read(void*, const Size) {
+    ASSERT(false);
+    return 0;
+}
+
+BufferSlice<const Byte> AsyncFileInputStream::next() {
+    ASSERT(false);
+    return BufferSlice<const Byte>(nullptr, nullptr);
+}
+
+bool AsyncFileInputStream::eof() const {
+    ASSERT(false);
+    return true;
+}
+
+void AsyncFileInputStream::close() {
+    ASSERT(false);
+}
+
+AsyncFileOutputStream::AsyncFileOutputStream(String fileName, const OpenMode, const AsyncFileOptions&)
+    : mFileName(std::move(fileName)) {
+    throw Exception("io_uring: Not supported on this platform");
+}
+
+AsyncFileOutputStream::~AsyncFileOutputStream() noexcept = default;
+
+void AsyncFileOutputStream::write(const void*, const Size) {
+    ASSERT(false);
+}
+
+void AsyncFileOutputStream::flush() {
+    ASSERT(false);
+}
+
+void AsyncFileOutputStream::close() {
+    ASSERT(false);
+}
+
+#endif
+
+} // namespace crypto
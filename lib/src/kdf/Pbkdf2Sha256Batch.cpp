@@ -0,0 +1,180 @@
+#include "cpplibcrypto/kdf/Pbkdf2Sha256Batch.h"
+#include "cpplibcrypto/common/Memory.h"
+#include "cpplibcrypto/hash/Hmac.h"
+#include "cpplibcrypto/hash/Sha256MultiBuffer.h"
+#include "cpplibcrypto/hash/Sha2.h"
+#include "cpplibcrypto/kdf/Pbkdf2Core.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace crypto {
+
+namespace {
+
+constexpr Size BLOCK_SIZE = Sha256::BLOCK_SIZE;
+constexpr Size DIGEST_SIZE = Pbkdf2Sha256Batch::DIGEST_SIZE;
+constexpr Size MAX_LANES = Sha256MultiBuffer::AVX512_LANES;
+
+using ProcessBlock = void (*)(Dword*, const Byte* const*);
+using HashState = Sha256::HashState;
+
+/// Computes the HMAC ipad and opad states for the given password
+void computeKeyStates(const Byte* password, const Size passwordSize, HashState& inner, HashState& outer) {
+    ByteBuffer key;
+    key.setSensitive();
+    key.insert(key.end(), password, password + passwordSize);
+    Hmac<Sha256> hmac;
+    hmac.setKey(HmacKey(std::move(key)));
+    inner = hmac.getInnerState();
+    outer = hmac.getOuterState();
+}
+
+/// The working memory of \ref deriveLanes(), wiped on destruction
+///
+/// The ipad/opad states are as good as the passwords, the rest holds parts of the derived keys.
+struct LaneStates {
+    // The states are transposed, 8 rows of laneCount words
+    alignas(64) Dword inner[8 * MAX_LANES];
+    alignas(64) Dword outer[8 * MAX_LANES];
+    alignas(64) Dword state[8 * MAX_LANES];
+    alignas(64) Dword accumulator[8 * MAX_LANES];
+    Byte blocks[MAX_LANES][BLOCK_SIZE];
+
+    ~LaneStates() { memory::wipe(this, sizeof(*this)); }
+};
+
+void deriveLanes(const Byte* const* passwords,
+                 const Size* passwordSizes,
+                 const Byte* const* salts,
+                 const Size* saltSizes,
+                 const Size count,
+                 const Size length,
+                 const Size iterations,
+                 Byte* out,
+                 const Size laneCount,
+                 const ProcessBlock processBlock) {
+    ASSERT(laneCount <= MAX_LANES);
+    const Size blocksPerKey = (length + DIGEST_SIZE - 1) / DIGEST_SIZE;
+    const Size jobs = count * blocksPerKey;
+
+    LaneStates states;
+    Dword* inner = states.inner;
+    Dword* outer = states.outer;
+    Dword* state = states.state;
+    Dword* accumulator = states.accumulator;
+    auto& blocks = states.blocks;
+    const Byte* pointers[MAX_LANES];
+    for (Size lane = 0; lane < laneCount; ++lane) {
+        Sha256::padFinalBlock(blocks[lane], DIGEST_SIZE, BLOCK_SIZE + DIGEST_SIZE);
+        pointers[lane] = blocks[lane];
+    }
+
+    // The jobs of a pair are consecutive, so the key states are computed once per pair even if its blocks
+    // are spread over two groups
+    Size keyStatesPair = count;
+    HashState innerState;
+    HashState outerState;
+
+    // Every job is one output block of one pair, a group of laneCount jobs runs all the iterations together
+    for (Size first = 0; first < jobs; first += laneCount) {
+        const Size lanes = std::min(laneCount, jobs - first);
+        for (Size lane = 0; lane < laneCount; ++lane) {
+            if (lane >= lanes) {
+                // An idle lane just keeps hashing whatever it got, its result is never stored
+                for (Size word = 0; word < 8; ++word) {
+                    inner[word * laneCount + lane] = 0;
+                    outer[word * laneCount + lane] = 0;
+                    state[word * laneCount + lane] = 0;
+                }
+                continue;
+            }
+            const Size pair = (first + lane) / blocksPerKey;
+            const Size block = (first + lane) % blocksPerKey;
+            if (pair != keyStatesPair) {
+                computeKeyStates(passwords[pair], passwordSizes[pair], innerState, outerState);
+                keyStatesPair = pair;
+            }
+            const HashState u1 = Pbkdf2Core<Sha256>::computeFirst(innerState, outerState, salts[pair],
+                                                                  saltSizes[pair], Dword(block + 1));
+            for (Size word = 0; word < 8; ++word) {
+                inner[word * laneCount + lane] = innerState[word];
+                outer[word * laneCount + lane] = outerState[word];
+                state[word * laneCount + lane] = u1[word];
+            }
+        }
+        std::memcpy(accumulator, state, 8 * laneCount * sizeof(Dword));
+
+        for (Size c = 1; c < iterations; ++c) {
+            for (const Dword* start : { inner, outer }) {
+                for (Size lane = 0; lane < laneCount; ++lane) {
+                    for (Size word = 0; word < 8; ++word) {
+                        bits::storeBigEndian(blocks[lane] + 4 * word, state[word * laneCount + lane]);
+                    }
+                }
+                std::memcpy(state, start, 8 * laneCount * sizeof(Dword));
+                processBlock(state, pointers);
+            }
+            for (Size i = 0; i < 8 * laneCount; ++i) {
+                accumulator[i] ^= state[i];
+            }
+        }
+
+        for (Size lane = 0; lane < lanes; ++lane) {
+            const Size pair = (first + lane) / blocksPerKey;
+            const Size block = (first + lane) % blocksPerKey;
+            Byte digest[DIGEST_SIZE];
+            for (Size word = 0; word < 8; ++word) {
+                bits::storeBigEndian(digest + 4 * word, accumulator[word * laneCount + lane]);
+            }
+            const Size offset = block * DIGEST_SIZE;
+            std::memcpy(out + pair * length + offset, digest, std::min(DIGEST_SIZE, length - offset));
+            memory::wipe(digest, sizeof(digest));
+        }
+    }
+}
+
+} // namespace
+
+void Pbkdf2Sha256Batch::derive(const Byte* const* passwords,
+                               const Size* passwordSizes,
+                               const Byte* const* salts,
+                               const Size* saltSizes,
+                               const Size count,
+                               const Size length,
+                               const Size iterations,
+                               Byte* out,
+                               const Implementation implementation) {
+    if (!Sha256Batch::isSupported(implementation)) {
+        throw Exception("PBKDF2 batch: Implementation not supported on this CPU");
+    }
+    switch (implementation) {
+    case Implementation::Avx512:
+        deriveLanes(passwords, passwordSizes, salts, saltSizes, count, length, iterations, out,
+                    Sha256MultiBuffer::AVX512_LANES, Sha256MultiBuffer::processBlockAvx512);
+        break;
+    case Implementation::Avx2:
+        deriveLanes(passwords, passwordSizes, salts, saltSizes, count, length, iterations, out,
+                    Sha256MultiBuffer::AVX2_LANES, Sha256MultiBuffer::processBlockAvx2);
+        break;
+    default: {
+        const Size blocksPerKey = (length + DIGEST_SIZE - 1) / DIGEST_SIZE;
+        for (Size pair = 0; pair < count; ++pair) {
+            HashState inner;
+            HashState outer;
+            computeKeyStates(passwords[pair], passwordSizes[pair], inner, outer);
+            for (Size block = 0; block < blocksPerKey; ++block) {
+                Byte digest[DIGEST_SIZE];
+                Pbkdf2Core<Sha256>::deriveBlock(inner, outer, salts[pair], saltSizes[pair], Dword(block + 1),
+                                                iterations, digest);
+                const Size offset = block * DIGEST_SIZE;
+                std::memcpy(out + pair * length + offset, digest, std::min(DIGEST_SIZE, length - offset));
+                memory::wipe(digest, sizeof(digest));
+            }
+        }
+        break;
+    }
+    }
+}
+
+} // namespace crypto
@@ -131,4 +131,26 @@ TEST(Aes256EncryptTest, encrypt4) {
     EXPECT_EQ(HexString("23304b7a39f9f3ff067d8d8f9e24ecc7"), HexString(Hex::encode(buffer)));
 }
 
+TEST(AesEncryptTest, rekey) {
+    Aes aes(AesKey(HexString("603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4")));
+    aes.setKey(AesKey(HexString("2b7e151628aed2a6abf7158809cf4f3c")));
+
+    StaticBuffer<Byte, 16> buffer;
+    buffer << HexString("6bc1bee22e409f96e93d7e117393172a");
+
+    aes.encryptBlock(buffer);
+    EXPECT_EQ(HexString("3ad77bb40d7a3660a89ecaf32466ef97"), HexString(Hex::encode(buffer)));
+}
+
+TEST(AesEncryptTest, move) {
+    Aes aes(AesKey(HexString("2b7e151628aed2a6abf7158809cf4f3c")));
+    Aes moved(std::move(aes));
+
+    StaticBuffer<Byte, 16> buffer;
+    buffer << HexString("6bc1bee22e409f96e93d7e117393172a");
+
+    moved.encryptBlock(buffer);
+    EXPECT_EQ(HexString("3ad77bb40d7a3660a89ecaf32466ef97"), HexString(Hex::encode(buffer)));
+}
+
 } // namespace crypto
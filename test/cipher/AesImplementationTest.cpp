@@ -0,0 +1,88 @@
+#include "gtest/gtest.h"
+
+#include "cpplibcrypto/buffer/DynamicBuffer.h"
+#include "cpplibcrypto/buffer/HexString.h"
+#include "cpplibcrypto/cipher/Aes.h"
+#include "cpplibcrypto/common/Hex.h"
+
+namespace crypto {
+
+class AesImplementationTest : public testing::TestWithParam<Aes::Implementation> {
+public:
+    void SetUp() override {
+        if (!Aes::isSupported(GetParam())) {
+            GTEST_SKIP();
+        }
+    }
+
+    /// Encrypts and decrypts the block with the given key, checking both the directions
+    void check(const HexString& key, const HexString& plaintext, const HexString& ciphertext) {
+        Aes aes(AesKey(key), GetParam());
+        EXPECT_EQ(GetParam(), aes.getImplementation());
+
+        StaticBuffer<Byte, 16> buffer;
+        buffer << plaintext;
+
+        aes.encryptBlock(buffer);
+        EXPECT_EQ(ciphertext, HexString(Hex::encode(buffer)));
+        aes.decryptBlock(buffer);
+        EXPECT_EQ(plaintext, HexString(Hex::encode(buffer)));
+    }
+};
+
+// FIPS-197, appendix C
+TEST_P(AesImplementationTest, aes128) {
+    check(HexString("000102030405060708090a0b0c0d0e0f"), HexString("00112233445566778899aabbccddeeff"),
+          HexString("69c4e0d86a7b0430d8cdb78070b4c55a"));
+}
+
+TEST_P(AesImplementationTest, aes192) {
+    check(HexString("000102030405060708090a0b0c0d0e0f1011121314151617"),
+          HexString("00112233445566778899aabbccddeeff"), HexString("dda97ca4864cdfe06eaf70a0ec0d7191"));
+}
+
+TEST_P(AesImplementationTest, aes256) {
+    check(HexString("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"),
+          HexString("00112233445566778899aabbccddeeff"), HexString("8ea2b7ca516745bfeafc49904b496089"));
+}
+
+TEST_P(AesImplementationTest, multipleBlocks) {
+    const AesKey key(HexString("603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4"));
+    Aes aes(key, GetParam());
+
+    // Enough blocks to go through both the parallel and the single block code paths
+    constexpr Size blocks = 19;
+    ByteBuffer plaintext;
+    for (Size i = 0; i < 16 * blocks; ++i) {
+        plaintext << Byte(i * 7);
+    }
+
+    ByteBuffer expected;
+    expected << plaintext;
+    static_cast<const BlockCipher&>(aes).BlockCipher::encryptBlocks(expected.data(), expected.data(), blocks);
+
+    ByteBuffer ciphertext(plaintext.size());
+    aes.encryptBlocks(plaintext.data(), ciphertext.data(), blocks);
+    EXPECT_EQ(expected, ciphertext);
+
+    aes.decryptBlocks(ciphertext.data(), ciphertext.data(), blocks);
+    EXPECT_EQ(plaintext, ciphertext);
+}
+
+INSTANTIATE_TEST_SUITE_P(Aes,
+                         AesImplementationTest,
+                         testing::Values(Aes::Implementation::TTable,
+                                         Aes::Implementation::AesNi,
+                                         Aes::Implementation::Bitsliced));
+
+TEST(AesImplementationTest, portableAlwaysSupported) {
+    EXPECT_TRUE(Aes::isSupported(Aes::Implementation::TTable));
+    EXPECT_TRUE(Aes::isSupported(Aes().getImplementation()));
+}
+
+TEST(AesImplementationTest, bitslicedIsOptIn) {
+    // Single blocks are several times slower bitsliced than with the lookup tables
+    EXPECT_NE(Aes::Implementation::Bitsliced, Aes::getDefaultImplementation());
+}
+
+} // namespace crypto
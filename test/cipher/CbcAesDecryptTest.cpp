@@ -201,4 +201,96 @@ TEST(CbcAes256DecryptResetChainTest, cbcDecryptResetChain1) {
     EXPECT_EQ(HexString("f69f2445df4f9b17ad2b417be66c3710"), HexString(Hex::encode(out2)));
 }
 
+TEST(CbcAes256DecryptTest, cbcDecryptMultipleBlocks) {
+    AesIv iv(HexString("39F23369A9D9BACFA530E26304231461"));
+    Aes aes(AesKey(HexString("603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4")));
+    CbcDecrypt cipher(aes, iv);
+
+    ByteBuffer buffer;
+    buffer << HexString("3f81c441d47f750c13ce8438cf7bcb12");
+    buffer << HexString("1f48175c755f420ef85d6af6b21507a9");
+    buffer << HexString("70a9724f666aaf0c4879b23b87460a0f");
+    buffer << HexString("f3382bb0dbc13fd8d9064a4261b62f35");
+
+    StaticBuffer<Byte, 64> out;
+    const Size processed = cipher.update(buffer, out);
+    cipher.finalize(out, Pkcs7());
+
+    ByteBuffer expected;
+    expected << HexString("000102030405060708090a0b0c0d0e0f");
+    expected << HexString("101112131415161718191a1b1c1d1e1f");
+    expected << HexString("00102030405060708090a0b0c0d0e0f0");
+    EXPECT_EQ(expected, HexString(Hex::encode(out)));
+    EXPECT_EQ(48U, processed);
+}
+
+TEST(CbcAes256DecryptTest, cbcDecryptChunked) {
+    AesIv iv(HexString("39F23369A9D9BACFA530E26304231461"));
+    Aes aes(AesKey(HexString("603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4")));
+
+    ByteBuffer plaintext;
+    for (Size i = 0; i < 1000; ++i) {
+        plaintext << Byte(i);
+    }
+    ByteBuffer ciphertext;
+    CbcEncrypt encryptor(aes, iv);
+    encryptor.update(plaintext, ciphertext);
+    encryptor.finalize(ciphertext, Pkcs7());
+
+    // Chunks not aligned to the block size, spanning several bulk runs
+    CbcDecrypt decryptor(aes, iv);
+    ByteBuffer out;
+    Size offset = 0;
+    const Byte* data = ciphertext.data();
+    for (const Size chunk : { 1, 7, 24, 200, 13, 16 }) {
+        decryptor.update(BufferSlice<const Byte>(data + offset, data + offset + chunk), out);
+        offset += chunk;
+    }
+    decryptor.update(BufferSlice<const Byte>(data + offset, data + ciphertext.size()), out);
+    decryptor.finalize(out, Pkcs7());
+    EXPECT_EQ(plaintext, out);
+}
+
+TEST(CbcAes256DecryptTest, cbcDecryptInPlace) {
+    AesIv iv(HexString("39F23369A9D9BACFA530E26304231461"));
+    Aes aes(AesKey(HexString("603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4")));
+
+    ByteBuffer plaintext;
+    for (Size i = 0; i < 1000; ++i) {
+        plaintext << Byte(i);
+    }
+    ByteBuffer ciphertext;
+    CbcEncrypt encryptor(aes, iv);
+    encryptor.update(plaintext, ciphertext);
+    encryptor.finalize(ciphertext, Pkcs7());
+
+    // The whole buffer at once, the output is the same memory as the input
+    ByteBuffer buffer;
+    buffer << ciphertext;
+    CbcDecrypt decryptor(aes, iv);
+    Size written = decryptor.update(buffer, BufferSlice<Byte>(buffer));
+    EXPECT_EQ(992U, written);
+    written += decryptor.finalize(BufferSlice<Byte>(buffer.data() + written, buffer.data() + 1008), Pkcs7());
+    EXPECT_EQ(1000U, written);
+    buffer.resize(written);
+    EXPECT_EQ(plaintext, buffer);
+
+    // Chunks not aligned to the block size, the output follows the input in the same buffer and the
+    // leftovers make it start before the input
+    ByteBuffer chunked;
+    chunked << ciphertext;
+    CbcDecrypt chunkedDecryptor(aes, iv);
+    Byte* data = chunked.data();
+    Size offset = 0;
+    written = 0;
+    for (const Size chunk : { 1, 7, 24, 200, 13, 16, 747 }) {
+        written += chunkedDecryptor.update(BufferSlice<const Byte>(data + offset, data + offset + chunk),
+                                           BufferSlice<Byte>(data + written, data + 1008));
+        offset += chunk;
+    }
+    written += chunkedDecryptor.finalize(BufferSlice<Byte>(data + written, data + 1008), Pkcs7());
+    chunked.resize(written);
+    EXPECT_EQ(plaintext, chunked);
+}
+
 } // namespace crypto
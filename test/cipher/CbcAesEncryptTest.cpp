@@ -7,6 +7,7 @@
 #include "cpplibcrypto/cipher/Aes.h"
 #include "cpplibcrypto/cipher/AesIv.h"
 #include "cpplibcrypto/cipher/CbcMode.h"
+#include "cpplibcrypto/common/Exception.h"
 #include "cpplibcrypto/common/Hex.h"
 #include "cpplibcrypto/padding/Pkcs7.h"
 
@@ -233,4 +234,57 @@ TEST(CbcAes256EncryptTest, cbcEncryptResetChain) {
     EXPECT_EQ(16U, processed2);
 }
 
+TEST(CbcAes256EncryptTest, cbcEncryptInPlace) {
+    AesIv iv(HexString("39F23369A9D9BACFA530E26304231461"));
+    Aes aes(AesKey(HexString("603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4")));
+
+    ByteBuffer plaintext;
+    for (Size i = 0; i < 1000; ++i) {
+        plaintext << Byte(i);
+    }
+    ByteBuffer expected;
+    CbcEncrypt reference(aes, iv);
+    reference.update(plaintext, expected);
+    reference.finalize(expected, Pkcs7());
+
+    // The whole buffer at once, the output is the same memory as the input
+    ByteBuffer buffer;
+    buffer << plaintext;
+    buffer.resize(1008);
+    CbcEncrypt cipher(aes, iv);
+    const BufferSlice<const Byte> input(buffer.data(), buffer.data() + 1000);
+    Size written = cipher.update(input, BufferSlice<Byte>(buffer));
+    written += cipher.finalize(BufferSlice<Byte>(buffer.data() + written, buffer.data() + 1008), Pkcs7());
+    EXPECT_EQ(1008U, written);
+    EXPECT_EQ(expected, buffer);
+
+    // Chunks not aligned to the block size, the output follows the input in the same buffer and the
+    // leftovers make it start at or before the input
+    ByteBuffer chunked;
+    chunked << plaintext;
+    chunked.resize(1008);
+    CbcEncrypt chunkedCipher(aes, iv);
+    Byte* data = chunked.data();
+    Size offset = 0;
+    written = 0;
+    for (const Size chunk : { 1, 7, 24, 200, 13, 16, 739 }) {
+        written += chunkedCipher.update(BufferSlice<const Byte>(data + offset, data + offset + chunk),
+                                        BufferSlice<Byte>(data + written, data + 1008));
+        offset += chunk;
+    }
+    written += chunkedCipher.finalize(BufferSlice<Byte>(data + written, data + 1008), Pkcs7());
+    EXPECT_EQ(1008U, written);
+    EXPECT_EQ(expected, chunked);
+}
+
+TEST(CbcAes256EncryptTest, cbcEncryptOutputTooSmall) {
+    AesIv iv(HexString("39F23369A9D9BACFA530E26304231461"));
+    Aes aes(AesKey(HexString("603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4")));
+    CbcEncrypt cipher(aes, iv);
+
+    ByteBuffer in(32);
+    ByteBuffer out(16);
+    EXPECT_THROW(cipher.update(in, BufferSlice<Byte>(out)), Exception);
+}
+
 } // namespace crypto
@@ -0,0 +1,128 @@
+#include "gtest/gtest.h"
+
+#include "cpplibcrypto/buffer/DynamicBuffer.h"
+#include "cpplibcrypto/buffer/HexString.h"
+#include "cpplibcrypto/cipher/Aes.h"
+#include "cpplibcrypto/cipher/AesIv.h"
+#include "cpplibcrypto/cipher/CtrMode.h"
+#include "cpplibcrypto/common/Hex.h"
+
+namespace crypto {
+
+namespace {
+
+ByteBuffer getPlaintext() {
+    ByteBuffer plaintext;
+    plaintext << HexString("6bc1bee22e409f96e93d7e117393172a");
+    plaintext << HexString("ae2d8a571e03ac9c9eb76fac45af8e51");
+    plaintext << HexString("30c81c46a35ce411e5fbc1191a0a52ef");
+    plaintext << HexString("f69f2445df4f9b17ad2b417be66c3710");
+    return plaintext;
+}
+
+} // namespace
+
+// NIST SP 800-38A, F.5.1
+TEST(CtrAes128Test, encrypt) {
+    AesIv iv(HexString("f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff"));
+    Aes aes(AesKey(HexString("2b7e151628aed2a6abf7158809cf4f3c")));
+    CtrCrypt cipher(aes, iv);
+
+    ByteBuffer plaintext = getPlaintext();
+    ByteBuffer out;
+    EXPECT_EQ(64U, cipher.update(plaintext, out));
+
+    ByteBuffer expected;
+    expected << HexString("874d6191b620e3261bef6864990db6ce");
+    expected << HexString("9806f66b7970fdff8617187bb9fffdff");
+    expected << HexString("5ae4df3edbd5d35e5b4f09020db03eab");
+    expected << HexString("1e031dda2fbe03d1792170a0f3009cee");
+    EXPECT_EQ(expected, HexString(Hex::encode(out)));
+}
+
+// NIST SP 800-38A, F.5.6
+TEST(CtrAes256Test, decrypt) {
+    AesIv iv(HexString("f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff"));
+    CtrMode<Aes>::Decryption cipher(
+        AesKey(HexString("603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4")), iv);
+
+    ByteBuffer ciphertext;
+    ciphertext << HexString("601ec313775789a5b7a7f504bbf3d228");
+    ciphertext << HexString("f443e3ca4d62b59aca84e990cacaf5c5");
+    ciphertext << HexString("2b0930daa23de94ce87017ba2d84988d");
+    ciphertext << HexString("dfc9c58db67aada613c2dd08457941a6");
+
+    ByteBuffer out;
+    cipher.update(ciphertext, out);
+    EXPECT_EQ(getPlaintext(), out);
+}
+
+TEST(CtrAes128Test, counterOverflow) {
+    AesIv iv(HexString("ffffffffffffffffffffffffffffffff"));
+    Aes aes(AesKey(HexString("2b7e151628aed2a6abf7158809cf4f3c")));
+    CtrCrypt cipher(aes, iv);
+
+    ByteBuffer zeros(32);
+    ByteBuffer out;
+    cipher.update(zeros, out);
+
+    ByteBuffer expected;
+    expected << HexString("8af2860142f786f409307c1a3f7eaaac");
+    expected << HexString("7df76b0c1ab899b33e42f047b91b546f");
+    EXPECT_EQ(expected, HexString(Hex::encode(out)));
+}
+
+TEST(CtrAes128Test, chunked) {
+    AesIv iv(HexString("f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff"));
+    Aes aes(AesKey(HexString("2b7e151628aed2a6abf7158809cf4f3c")));
+
+    ByteBuffer plaintext;
+    for (Size i = 0; i < 1000; ++i) {
+        plaintext << Byte(i);
+    }
+    ByteBuffer expected;
+    CtrCrypt(aes, iv).update(plaintext, expected);
+
+    CtrCrypt cipher(aes, iv);
+    ByteBuffer out;
+    const Byte* data = plaintext.data();
+    Size offset = 0;
+    for (const Size chunk : { 1, 7, 3, 200, 13, 16, 160 }) {
+        cipher.update(BufferSlice<const Byte>(data + offset, data + offset + chunk), out);
+        offset += chunk;
+    }
+    cipher.update(BufferSlice<const Byte>(data + offset, data + plaintext.size()), out);
+    EXPECT_EQ(expected, out);
+}
+
+TEST(CtrAes128Test, seek) {
+    AesIv iv(HexString("f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff"));
+    Aes aes(AesKey(HexString("2b7e151628aed2a6abf7158809cf4f3c")));
+
+    ByteBuffer plaintext;
+    for (Size i = 0; i < 1000; ++i) {
+        plaintext << Byte(i);
+    }
+    ByteBuffer ciphertext;
+    CtrCrypt(aes, iv).update(plaintext, ciphertext);
+
+    CtrCrypt cipher(aes, iv);
+    for (const Size offset : { 0, 5, 16, 333, 999 }) {
+        cipher.seek(offset);
+        const Size length = std::min<Size>(100, plaintext.size() - offset);
+        ByteBuffer out;
+        const Byte* data = ciphertext.data() + offset;
+        cipher.update(BufferSlice<const Byte>(data, data + length), out);
+
+        ByteBuffer expected;
+        expected.insert(expected.end(), plaintext.begin() + offset, plaintext.begin() + offset + length);
+        EXPECT_EQ(expected, out);
+    }
+
+    cipher.resetChain();
+    ByteBuffer out;
+    cipher.update(ciphertext, out);
+    EXPECT_EQ(plaintext, out);
+}
+
+} // namespace crypto
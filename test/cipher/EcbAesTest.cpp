@@ -0,0 +1,81 @@
+#include "gtest/gtest.h"
+
+#include "cpplibcrypto/buffer/DynamicBuffer.h"
+#include "cpplibcrypto/buffer/HexString.h"
+#include "cpplibcrypto/cipher/Aes.h"
+#include "cpplibcrypto/cipher/EcbMode.h"
+#include "cpplibcrypto/common/Exception.h"
+#include "cpplibcrypto/common/Hex.h"
+
+namespace crypto {
+
+namespace {
+
+ByteBuffer getPlaintext() {
+    ByteBuffer plaintext;
+    plaintext << HexString("6bc1bee22e409f96e93d7e117393172a");
+    plaintext << HexString("ae2d8a571e03ac9c9eb76fac45af8e51");
+    plaintext << HexString("30c81c46a35ce411e5fbc1191a0a52ef");
+    plaintext << HexString("f69f2445df4f9b17ad2b417be66c3710");
+    return plaintext;
+}
+
+} // namespace
+
+// NIST SP 800-38A, F.1.1
+TEST(EcbAes128Test, encrypt) {
+    EcbMode<Aes>::Encryption cipher(AesKey(HexString("2b7e151628aed2a6abf7158809cf4f3c")));
+
+    ByteBuffer data = getPlaintext();
+    cipher.update(data);
+
+    ByteBuffer expected;
+    expected << HexString("3ad77bb40d7a3660a89ecaf32466ef97");
+    expected << HexString("f5d3d58503b9699de785895a96fdbaaf");
+    expected << HexString("43b1cd7f598ece23881b00e3ed030688");
+    expected << HexString("7b0c785e27e8ad3f8223207104725dd4");
+    EXPECT_EQ(expected, data);
+}
+
+// NIST SP 800-38A, F.1.6
+TEST(EcbAes256Test, decrypt) {
+    EcbMode<Aes>::Decryption cipher(
+        AesKey(HexString("603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4")));
+
+    ByteBuffer ciphertext;
+    ciphertext << HexString("f3eed1bdb5d2a03c064b5a7e3db181f8");
+    ciphertext << HexString("591ccb10d410ed26dc5ba74a31362870");
+    ciphertext << HexString("b6ed21b99ca6f4f9f153e7b1beafed1d");
+    ciphertext << HexString("23304b7a39f9f3ff067d8d8f9e24ecc7");
+
+    ByteBuffer out(ciphertext.size());
+    cipher.update(ciphertext.data(), out.data(), 4);
+    EXPECT_EQ(getPlaintext(), out);
+}
+
+TEST(EcbAes128Test, roundTrip) {
+    // More blocks than the multi-block paths handle at once
+    ByteBuffer data;
+    for (Size i = 0; i < 16 * 37; ++i) {
+        data.push(Byte(i * 31 + 7));
+    }
+    ByteBuffer original;
+    original << data;
+
+    const AesKey key(HexString("000102030405060708090a0b0c0d0e0f"));
+    EcbMode<Aes>::Encryption encryption(key);
+    encryption.update(data);
+    EXPECT_NE(original, data);
+
+    EcbMode<Aes>::Decryption decryption(key);
+    decryption.update(data);
+    EXPECT_EQ(original, data);
+}
+
+TEST(EcbAes128Test, partialBlock) {
+    EcbMode<Aes>::Encryption cipher(AesKey(HexString("2b7e151628aed2a6abf7158809cf4f3c")));
+    ByteBuffer data(17);
+    EXPECT_THROW(cipher.update(data), Exception);
+}
+
+} // namespace crypto
@@ -0,0 +1,245 @@
+#include "gtest/gtest.h"
+
+#include "cpplibcrypto/buffer/DynamicBuffer.h"
+#include "cpplibcrypto/buffer/HexString.h"
+#include "cpplibcrypto/cipher/Aes.h"
+#include "cpplibcrypto/cipher/AesIv.h"
+#include "cpplibcrypto/cipher/GcmIv.h"
+#include "cpplibcrypto/cipher/GcmMode.h"
+#include "cpplibcrypto/common/Exception.h"
+#include "cpplibcrypto/common/Hex.h"
+
+namespace crypto {
+
+// The test cases come from "The Galois/Counter Mode of Operation (GCM)" by McGrew and Viega
+
+TEST(GcmAes128Test, encryptBlock) {
+    GcmIv iv(HexString("000000000000000000000000"));
+    Aes aes(AesKey(HexString("00000000000000000000000000000000")));
+    GcmEncrypt cipher(aes, iv);
+
+    ByteBuffer buffer(16);
+    ByteBuffer out;
+    EXPECT_EQ(16U, cipher.update(buffer, out));
+    EXPECT_EQ(HexString("0388dace60b6a392f328c2b971b2fe78"), HexString(Hex::encode(out)));
+
+    ByteBuffer tag;
+    cipher.finalize(tag);
+    EXPECT_EQ(HexString("ab6e47d42cec13bdf53a67b21257bddf"), HexString(Hex::encode(tag)));
+}
+
+TEST(GcmAes128Test, emptyMessage) {
+    GcmIv iv(HexString("000000000000000000000000"));
+    Aes aes(AesKey(HexString("00000000000000000000000000000000")));
+    GcmEncrypt cipher(aes, iv);
+
+    ByteBuffer tag;
+    cipher.finalize(tag);
+    EXPECT_EQ(HexString("58e2fccefa7e3061367f1d57a4e7455a"), HexString(Hex::encode(tag)));
+}
+
+TEST(GcmAes128Test, encryptWithAad) {
+    GcmIv iv(HexString("cafebabefacedbaddecaf888"));
+    GcmMode<Aes>::Encryption cipher(AesKey(HexString("feffe9928665731c6d6a8f9467308308")), iv);
+
+    ByteBuffer aad;
+    aad << HexString("feedfacedeadbeeffeedfacedeadbeefabaddad2");
+    cipher.updateAad(aad);
+
+    ByteBuffer buffer;
+    buffer << HexString("d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72");
+    buffer << HexString("1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39");
+    ByteBuffer out;
+    cipher.update(buffer, out);
+
+    ByteBuffer expected;
+    expected << HexString("42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e");
+    expected << HexString("21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091");
+    EXPECT_EQ(expected, HexString(Hex::encode(out)));
+
+    ByteBuffer tag;
+    cipher.finalize(tag);
+    EXPECT_EQ(HexString("5bc94fbc3221a5db94fae95ae7121a47"), HexString(Hex::encode(tag)));
+}
+
+TEST(GcmAes256Test, decryptWithAad) {
+    GcmIv iv(HexString("cafebabefacedbaddecaf888"));
+    GcmMode<Aes>::Decryption cipher(
+        AesKey(HexString("feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308")), iv);
+
+    ByteBuffer aad;
+    aad << HexString("feedfacedeadbeeffeedfacedeadbeefabaddad2");
+    cipher.updateAad(aad);
+
+    ByteBuffer buffer;
+    buffer << HexString("522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa");
+    buffer << HexString("8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662");
+    ByteBuffer out;
+    cipher.update(buffer, out);
+
+    ByteBuffer expected;
+    expected << HexString("d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72");
+    expected << HexString("1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39");
+    EXPECT_EQ(expected, HexString(Hex::encode(out)));
+
+    ByteBuffer tag;
+    tag << HexString("76fc6ece0f4e1768cddf8853bb2d551b");
+    EXPECT_NO_THROW(cipher.finalize(tag));
+}
+
+TEST(GcmAes128Test, nonStandardIvSize) {
+    AesIv iv(HexString("000102030405060708090a0b0c0d0e0f"));
+    Aes aes(AesKey(HexString("feffe9928665731c6d6a8f9467308308")));
+    GcmEncrypt cipher(aes, iv);
+
+    String header("header");
+    cipher.updateAad(BufferSlice<const Byte>(reinterpret_cast<const Byte*>(header.data()),
+                                             reinterpret_cast<const Byte*>(header.data() + header.size())));
+    ByteBuffer buffer;
+    for (Size i = 0; i < 100; ++i) {
+        buffer << Byte(i);
+    }
+    ByteBuffer out;
+    cipher.update(buffer, out);
+    ByteBuffer tag;
+    cipher.finalize(tag);
+
+    ByteBuffer expected;
+    expected << HexString("4a0316b98d11749ea110f72828de63592293503f00476c652867dde38f9fe149");
+    expected << HexString("ae8ac49b72b5a34e2cfa54385dba443d14c66f95fa176069262b44570ac8c418");
+    expected << HexString("d9f9cad14a28a356eeaf1c7aab1af2e17ebe128e69450498f9fd00a1c42d2022");
+    expected << HexString("a946d630");
+    EXPECT_EQ(expected, HexString(Hex::encode(out)));
+    EXPECT_EQ(HexString("2a5dedf1b16215b10dd5e2abb4fd67e1"), HexString(Hex::encode(tag)));
+}
+
+TEST(GcmAes128Test, chunked) {
+    GcmIv iv(HexString("cafebabefacedbaddecaf888"));
+    Aes aes(AesKey(HexString("feffe9928665731c6d6a8f9467308308")));
+
+    ByteBuffer aad;
+    for (Size i = 0; i < 37; ++i) {
+        aad << Byte(i);
+    }
+    ByteBuffer plaintext;
+    for (Size i = 0; i < 1000; ++i) {
+        plaintext << Byte(i * 7);
+    }
+
+    GcmEncrypt encryptor(aes, iv);
+    encryptor.updateAad(BufferSlice<const Byte>(aad.data(), aad.data() + 5));
+    encryptor.updateAad(BufferSlice<const Byte>(aad.data() + 5, aad.data() + 20));
+    encryptor.updateAad(BufferSlice<const Byte>(aad.data() + 20, aad.data() + aad.size()));
+    ByteBuffer ciphertext;
+    const Byte* data = plaintext.data();
+    Size offset = 0;
+    for (const Size chunk : { 1, 7, 24, 300, 13, 16 }) {
+        encryptor.update(BufferSlice<const Byte>(data + offset, data + offset + chunk), ciphertext);
+        offset += chunk;
+    }
+    encryptor.update(BufferSlice<const Byte>(data + offset, data + plaintext.size()), ciphertext);
+    ByteBuffer tag;
+    encryptor.finalize(tag);
+    EXPECT_EQ(HexString("61b67960a36d209f271150811e82dffc"), HexString(Hex::encode(tag)));
+
+    GcmDecrypt decryptor(aes, iv);
+    decryptor.updateAad(aad);
+    ByteBuffer out;
+    decryptor.update(ciphertext, out);
+    EXPECT_NO_THROW(decryptor.finalize(tag));
+    EXPECT_EQ(plaintext, out);
+}
+
+TEST(GcmAes128Test, tamperedCiphertext) {
+    GcmIv iv(HexString("000000000000000000000000"));
+    Aes aes(AesKey(HexString("00000000000000000000000000000000")));
+    GcmDecrypt cipher(aes, iv);
+
+    ByteBuffer buffer;
+    buffer << HexString("0388dace60b6a392f328c2b971b2fe79");
+    ByteBuffer out;
+    cipher.update(buffer, out);
+
+    ByteBuffer tag;
+    tag << HexString("ab6e47d42cec13bdf53a67b21257bddf");
+    EXPECT_THROW(cipher.finalize(tag), Exception);
+}
+
+TEST(GcmAes128Test, aadAfterMessage) {
+    GcmIv iv(HexString("000000000000000000000000"));
+    Aes aes(AesKey(HexString("00000000000000000000000000000000")));
+    GcmEncrypt cipher(aes, iv);
+
+    ByteBuffer buffer(16);
+    ByteBuffer out;
+    cipher.update(buffer, out);
+    EXPECT_THROW(cipher.updateAad(buffer), Exception);
+}
+
+TEST(GcmAes128Test, encryptAfterFinalize) {
+    GcmIv iv(HexString("000000000000000000000000"));
+    Aes aes(AesKey(HexString("00000000000000000000000000000000")));
+    GcmEncrypt cipher(aes, iv);
+
+    ByteBuffer buffer(16);
+    ByteBuffer out;
+    cipher.update(buffer, out);
+    ByteBuffer tag;
+    cipher.finalize(tag);
+    EXPECT_EQ(GcmEncrypt::TAG_SIZE, tag.size());
+
+    EXPECT_THROW(cipher.finalize(tag), Exception);
+    EXPECT_THROW(cipher.update(buffer, out), Exception);
+    EXPECT_THROW(cipher.updateAad(buffer), Exception);
+    EXPECT_EQ(GcmEncrypt::TAG_SIZE, tag.size());
+    EXPECT_EQ(16U, out.size());
+}
+
+TEST(GcmAes128Test, decryptAfterFinalize) {
+    GcmIv iv(HexString("000000000000000000000000"));
+    Aes aes(AesKey(HexString("00000000000000000000000000000000")));
+    GcmDecrypt cipher(aes, iv);
+
+    ByteBuffer tag;
+    tag << HexString("58e2fccefa7e3061367f1d57a4e7455a");
+    cipher.finalize(tag);
+
+    ByteBuffer buffer(16);
+    ByteBuffer out;
+    EXPECT_THROW(cipher.finalize(tag), Exception);
+    EXPECT_THROW(cipher.update(buffer, out), Exception);
+    EXPECT_THROW(cipher.updateAad(buffer), Exception);
+    EXPECT_TRUE(out.empty());
+}
+
+class GhashTest : public testing::TestWithParam<Ghash::Implementation> {
+public:
+    void SetUp() override {
+        if (!Ghash::isSupported(GetParam())) {
+            GTEST_SKIP();
+        }
+    }
+};
+
+TEST_P(GhashTest, multipleBlocks) {
+    ByteBuffer h;
+    h << HexString("66e94bd4ef8a2c3b884cfa59ca342b2e");
+    Ghash ghash(h.data(), GetParam());
+    EXPECT_EQ(GetParam(), ghash.getImplementation());
+
+    // Enough blocks to go through both the aggregated and the single block code paths
+    ByteBuffer data;
+    for (Size i = 0; i < 80; ++i) {
+        data << Byte(i);
+    }
+    ghash.update(data.data(), 5);
+
+    StaticBuffer<Byte, 16> state(ghash.getState(), ghash.getState() + 16);
+    EXPECT_EQ(HexString("71e5afe18713ce39b1869ce4182d3120"), HexString(Hex::encode(state)));
+}
+
+INSTANTIATE_TEST_SUITE_P(Gcm,
+                         GhashTest,
+                         testing::Values(Ghash::Implementation::Table, Ghash::Implementation::Clmul));
+
+} // namespace crypto
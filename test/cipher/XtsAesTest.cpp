@@ -0,0 +1,121 @@
+#include "gtest/gtest.h"
+
+#include "cpplibcrypto/buffer/DynamicBuffer.h"
+#include "cpplibcrypto/buffer/HexString.h"
+#include "cpplibcrypto/cipher/Aes.h"
+#include "cpplibcrypto/cipher/XtsMode.h"
+#include "cpplibcrypto/common/Exception.h"
+#include "cpplibcrypto/common/Hex.h"
+#include "cpplibcrypto/hash/Sha2.h"
+
+namespace crypto {
+
+namespace {
+
+ByteBuffer getSequence(const Size size) {
+    ByteBuffer data;
+    for (Size i = 0; i < size; ++i) {
+        data.push(Byte(i));
+    }
+    return data;
+}
+
+HexString sha256(const ByteBuffer& data) {
+    Sha256 sha;
+    sha.update(data);
+    ByteBuffer digest(Sha256::DIGEST_SIZE);
+    sha.finalize(digest);
+    return HexString(Hex::encode(digest));
+}
+
+const AesKey& getDataKey256() {
+    static const AesKey key(HexString("2718281828459045235360287471352662497757247093699959574966967627"));
+    return key;
+}
+
+const AesKey& getTweakKey256() {
+    static const AesKey key(HexString("3141592653589793238462643383279502884197169399375105820974944592"));
+    return key;
+}
+
+} // namespace
+
+// IEEE 1619-2007, vector 2
+TEST(XtsAes128Test, encrypt) {
+    XtsMode<Aes>::Encryption cipher(AesKey(HexString("11111111111111111111111111111111")),
+                                    AesKey(HexString("22222222222222222222222222222222")));
+    ByteBuffer data(32, 0x44);
+    cipher.update(0x3333333333, data);
+    EXPECT_EQ(HexString("c454185e6a16936e39334038acef838bfb186fff7480adc4289382ecd6d394f0"),
+              HexString(Hex::encode(data)));
+}
+
+// IEEE 1619-2007, vector 15
+TEST(XtsAes128Test, ciphertextStealing) {
+    const AesKey dataKey(HexString("fffefdfcfbfaf9f8f7f6f5f4f3f2f1f0"));
+    const AesKey tweakKey(HexString("bfbebdbcbbbab9b8b7b6b5b4b3b2b1b0"));
+    const ByteBuffer plaintext = getSequence(17);
+    ByteBuffer ciphertext(17);
+    XtsMode<Aes>::Encryption encryption(dataKey, tweakKey);
+    encryption.update(0x123456789a, plaintext.data(), ciphertext.data(), ciphertext.size());
+    EXPECT_EQ(HexString("6c1625db4671522d3d7599601de7ca09ed"), HexString(Hex::encode(ciphertext)));
+
+    XtsMode<Aes>::Decryption decryption(dataKey, tweakKey);
+    decryption.update(0x123456789a, ciphertext);
+    EXPECT_EQ(plaintext, ciphertext);
+}
+
+// IEEE 1619-2007, vector 10
+TEST(XtsAes256Test, sector) {
+    ByteBuffer data = getSequence(256);
+    data << getSequence(256);
+    XtsMode<Aes>::Encryption encryption(getDataKey256(), getTweakKey256());
+    encryption.update(0xff, data);
+    EXPECT_EQ(HexString("1c3b3a102f770386e4836c99e370cf9bea00803f5e482357a4ae12d414a3e63b"),
+              HexString(Hex::encode(BufferSlice<Byte>(data.data(), data.data() + 32))));
+    EXPECT_EQ(HexString("e97e974fa393af794f7a4684395814cf820de60a01eaec677d87b452e316b364"), sha256(data));
+
+    XtsMode<Aes>::Decryption decryption(getDataKey256(), getTweakKey256());
+    decryption.update(0xff, data);
+    ByteBuffer expected = getSequence(256);
+    expected << getSequence(256);
+    EXPECT_EQ(expected, data);
+}
+
+TEST(XtsAes256Test, partialBlockAfterManyBlocks) {
+    // 19 whole blocks and 12 more bytes, the stealing follows more than one run of tweaks
+    ByteBuffer data = getSequence(256);
+    data << getSequence(60);
+    XtsMode<Aes>::Encryption encryption(getDataKey256(), getTweakKey256());
+    encryption.update(0x1234, data);
+    EXPECT_EQ(HexString("18b5164ddd18a9ecf3aaae685bc700c05a1dda94505fc6a3c5459f0271ea4518"), sha256(data));
+
+    XtsMode<Aes>::Decryption decryption(getDataKey256(), getTweakKey256());
+    decryption.update(0x1234, data);
+    ByteBuffer expected = getSequence(256);
+    expected << getSequence(60);
+    EXPECT_EQ(expected, data);
+}
+
+TEST(XtsAes128Test, shortSector) {
+    XtsMode<Aes>::Encryption cipher(AesKey(HexString("11111111111111111111111111111111")),
+                                    AesKey(HexString("22222222222222222222222222222222")));
+    ByteBuffer data(15);
+    EXPECT_THROW(cipher.update(0, data), Exception);
+}
+
+TEST(XtsAes128Test, longSector) {
+    XtsMode<Aes>::Encryption cipher(AesKey(HexString("11111111111111111111111111111111")),
+                                    AesKey(HexString("22222222222222222222222222222222")));
+    ByteBuffer data(XtsCrypt::MAX_SECTOR_SIZE + 1);
+    EXPECT_THROW(cipher.update(0, data), Exception);
+}
+
+TEST(XtsAes128Test, sameKeys) {
+    const AesKey key(HexString("11111111111111111111111111111111"));
+    EXPECT_THROW(XtsMode<Aes>::Encryption(key, key), Exception);
+    EXPECT_THROW(XtsMode<Aes>::Decryption(key, AesKey(HexString("11111111111111111111111111111111"))),
+                 Exception);
+}
+
+} // namespace crypto
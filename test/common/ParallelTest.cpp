@@ -0,0 +1,66 @@
+#include "gtest/gtest.h"
+
+#include "cpplibcrypto/common/Exception.h"
+#include "cpplibcrypto/common/Parallel.h"
+
+#include <atomic>
+#include <new>
+#include <vector>
+
+namespace crypto {
+
+TEST(ParallelTest, everyIndexOnce) {
+    for (const Size threadCount : { 0, 1, 3, 64 }) {
+        std::vector<std::atomic<int>> visits(1000);
+        parallel::forEach(visits.size(), threadCount, [&visits](const Size index) { ++visits[index]; });
+        for (const auto& count : visits) {
+            ASSERT_EQ(1, count.load()) << threadCount;
+        }
+    }
+}
+
+TEST(ParallelTest, noIndices) {
+    bool called = false;
+    parallel::forEach(0, 4, [&called](Size) { called = true; });
+    EXPECT_FALSE(called);
+}
+
+TEST(ParallelTest, stateIsPerThread) {
+    struct State {
+        Size processed = 0;
+    };
+    std::atomic<Size> total(0);
+    parallel::forEachWithState<State>(500, 4, [&total](Size, State& state) {
+        // Nobody else touches the state, so it needs no synchronization
+        ++state.processed;
+        ++total;
+    });
+    EXPECT_EQ(500U, total.load());
+}
+
+TEST(ParallelTest, exceptionIsRethrown) {
+    std::atomic<Size> processed(0);
+    EXPECT_THROW(parallel::forEach(1000, 4,
+                                   [&processed](const Size index) {
+                                       if (index == 10) {
+                                           throw Exception("failed");
+                                       }
+                                       ++processed;
+                                   }),
+                 Exception);
+    EXPECT_LT(processed.load(), 1000U);
+}
+
+TEST(ParallelTest, stateConstructorExceptionIsRethrown) {
+    struct State {
+        State() { throw std::bad_alloc(); }
+    };
+    EXPECT_THROW(parallel::forEachWithState<State>(10, 3, [](Size, State&) {}), std::bad_alloc);
+}
+
+TEST(ParallelTest, resolveThreadCount) {
+    EXPECT_EQ(3U, parallel::resolveThreadCount(3));
+    EXPECT_GE(parallel::resolveThreadCount(0), 1U);
+}
+
+} // namespace crypto
@@ -0,0 +1,49 @@
+#include "gtest/gtest.h"
+
+#include "cpplibcrypto/common/SpscQueue.h"
+
+#include <thread>
+
+namespace crypto {
+
+TEST(SpscQueueTest, fullAndEmpty) {
+    SpscQueue<int> queue(2);
+    int item = 0;
+    EXPECT_FALSE(queue.tryPop(item));
+    EXPECT_TRUE(queue.tryPush(1));
+    EXPECT_TRUE(queue.tryPush(2));
+    EXPECT_FALSE(queue.tryPush(3));
+    EXPECT_TRUE(queue.tryPop(item));
+    EXPECT_EQ(1, item);
+    EXPECT_TRUE(queue.tryPush(3));
+    EXPECT_TRUE(queue.tryPop(item));
+    EXPECT_EQ(2, item);
+    EXPECT_TRUE(queue.tryPop(item));
+    EXPECT_EQ(3, item);
+    EXPECT_FALSE(queue.tryPop(item));
+}
+
+TEST(SpscQueueTest, twoThreads) {
+    constexpr int COUNT = 100000;
+    SpscQueue<int> queue(16);
+    std::thread producer([&queue] {
+        for (int i = 0; i < COUNT; ++i) {
+            while (!queue.tryPush(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    int expected = 0;
+    while (expected < COUNT) {
+        int item;
+        if (queue.tryPop(item)) {
+            ASSERT_EQ(expected, item);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+}
+
+} // namespace crypto
@@ -7,6 +7,7 @@
 #include "cpplibcrypto/hash/Hmac.h"
 #include "cpplibcrypto/hash/Md5.h"
 #include "cpplibcrypto/hash/Sha1.h"
+#include "cpplibcrypto/hash/Sha2.h"
 
 namespace crypto {
 
@@ -52,6 +53,50 @@ TEST(HmacTest, sha1case1) {
     EXPECT_TRUE(bufferUtils::equal(Hex::decode("de7c9b85b8b78aa6bc8a7a36f70a90701c9db4d9"), digest));
 }
 
+TEST(HmacTest, sha512case1) {
+    // RFC 4231, test case 1
+    Hmac<Sha512> hmac(ByteBuffer(20, 0x0b));
+    hmac.update(String("Hi There"));
+
+    StaticBuffer<Byte, Sha512::DIGEST_SIZE> digest(Sha512::DIGEST_SIZE);
+    hmac.finalize(digest);
+    const auto expected = Hex::decode("87aa7cdea5ef619d4ff0b4241a1d6cb02379f4e2ce4ec2787ad0b30545e17cde"
+                                      "daa833b7d6b8a702038b274eaea3f4e4be9d914eeb61f1702e696c203a126854");
+    EXPECT_TRUE(bufferUtils::equal(expected, digest));
+}
+
+TEST(HmacTest, sha512longKey) {
+    // RFC 4231, test case 6, the key is longer than the 128 byte block
+    Hmac<Sha512> hmac(ByteBuffer(131, 0xaa));
+    hmac.update(String("Test Using Larger Than Block-Size Key - Hash Key First"));
+
+    StaticBuffer<Byte, Sha512::DIGEST_SIZE> digest(Sha512::DIGEST_SIZE);
+    hmac.finalize(digest);
+    const auto expected = Hex::decode("80b24263c7c1a3ebb71493c1dd7be8b49b46d1f41b4aeec1121b013783f8f352"
+                                      "6b56d037e05f2598bd0fd2215d6a1e5295e64f73f63f0aec8b915a985d786598");
+    EXPECT_TRUE(bufferUtils::equal(expected, digest));
+}
+
+TEST(HmacTest, sha256reuse) {
+    // RFC 4231, test case 2, every digest starts over from the precomputed key states
+    Hmac<Sha256> hmac(ByteBuffer{ 'J', 'e', 'f', 'e' });
+    StaticBuffer<Byte, Sha256::DIGEST_SIZE> digest(Sha256::DIGEST_SIZE);
+    const auto expected = Hex::decode("5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843");
+
+    ByteBuffer longMessage(1000, 0x61);
+    hmac.update(longMessage);
+    hmac.finalize(digest);
+    EXPECT_FALSE(bufferUtils::equal(expected, digest));
+
+    for (int i = 0; i < 2; ++i) {
+        hmac.reset();
+        hmac.update(String("what do ya want "));
+        hmac.update(String("for nothing?"));
+        hmac.finalize(digest);
+        EXPECT_TRUE(bufferUtils::equal(expected, digest));
+    }
+}
+
 TEST(HmacTest, reset) {
     Hmac<Md5> hmac(HmacKey{});
     hmac.update(String(""));
@@ -83,6 +83,31 @@ TEST(Md5Test, reset) {
     EXPECT_TRUE(bufferUtils::equal(Hex::decode("900150983cd24fb0d6963f7d28e17f72"), digest));
 }
 
+TEST(Md5Test, chunked) {
+    ByteBuffer message;
+    for (Size i = 0; i < 1000; ++i) {
+        message.push(Byte(i));
+    }
+
+    Md5 oneShot;
+    oneShot.update(message);
+    StaticBuffer<Byte, Md5::DIGEST_SIZE> expected(Md5::DIGEST_SIZE);
+    oneShot.finalize(expected);
+
+    // Chunks that start and end both on and off the block boundaries
+    Md5 md5;
+    Size offset = 0;
+    for (const Size chunk : { 1U, 63U, 64U, 65U, 0U, 127U, 128U, 200U }) {
+        md5.update(message.data() + offset, chunk);
+        offset += chunk;
+    }
+    md5.update(message.data() + offset, message.size() - offset);
+
+    StaticBuffer<Byte, Md5::DIGEST_SIZE> digest(Md5::DIGEST_SIZE);
+    md5.finalize(digest);
+    EXPECT_TRUE(bufferUtils::equal(expected, digest));
+}
+
 TEST(Md5Test, move) {
     Md5 md5;
     md5.update(String("abc"));
@@ -98,4 +98,40 @@ TEST(Sha1Test, move) {
     EXPECT_TRUE(bufferUtils::equal(Hex::decode("a9993e364706816aba3e25717850c26c9cd0d89d"), digest));
 }
 
+class Sha1ImplementationTest : public testing::TestWithParam<sha::Implementation> {
+public:
+    void SetUp() override {
+        if (!sha::isSupported(GetParam())) {
+            GTEST_SKIP();
+        }
+    }
+};
+
+TEST_P(Sha1ImplementationTest, processBlocks) {
+    // "abc" padded to a single block, followed by the two blocks of case2
+    ByteBuffer blocks;
+    blocks << Hex::decode("61626380000000000000000000000000000000000000000000000000000000000000000000000000"
+                          "000000000000000000000000000000000000000000000018");
+    const String message("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq");
+    blocks.insert(blocks.end(), message.begin(), message.end());
+    blocks.push(0x80);
+    blocks.insert(blocks.end(), 0x00, 3 * Sha1::BLOCK_SIZE - blocks.size() - 2);
+    blocks.push(0x01);
+    blocks.push(0xc0);
+
+    sha::State<sha::Family::SHA1> state;
+    Sha1::processBlocks(state, blocks.data(), 1, GetParam());
+    EXPECT_EQ(0xa9993e36U, state[0]);
+    EXPECT_EQ(0x9cd0d89dU, state[4]);
+
+    state.reset();
+    Sha1::processBlocks(state, blocks.data() + Sha1::BLOCK_SIZE, 2, GetParam());
+    EXPECT_EQ(0x84983e44U, state[0]);
+    EXPECT_EQ(0xe54670f1U, state[4]);
+}
+
+INSTANTIATE_TEST_SUITE_P(Sha1,
+                         Sha1ImplementationTest,
+                         testing::Values(sha::Implementation::Portable, sha::Implementation::ShaNi));
+
 } // namespace crypto
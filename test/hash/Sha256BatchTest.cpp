@@ -0,0 +1,90 @@
+#include "gtest/gtest.h"
+
+#include "cpplibcrypto/buffer/DynamicBuffer.h"
+#include "cpplibcrypto/buffer/String.h"
+#include "cpplibcrypto/buffer/utils/bufferUtils.h"
+#include "cpplibcrypto/common/Exception.h"
+#include "cpplibcrypto/common/Hex.h"
+#include "cpplibcrypto/hash/Sha256Batch.h"
+#include "cpplibcrypto/hash/Sha2.h"
+
+namespace crypto {
+
+class Sha256BatchTest : public testing::TestWithParam<Sha256Batch::Implementation> {
+public:
+    void SetUp() override {
+        if (!Sha256Batch::isSupported(GetParam())) {
+            GTEST_SKIP();
+        }
+    }
+};
+
+TEST_P(Sha256BatchTest, matchesSha256) {
+    // Sizes around the padding boundaries and a few long messages, more messages than lanes so the lanes
+    // get refilled while others are still busy
+    ByteBuffer data;
+    for (Size i = 0; i < 5000; ++i) {
+        data.push(Byte(i * 7 + 3));
+    }
+    DynamicBuffer<const Byte*> messages;
+    DynamicBuffer<Size> sizes;
+    for (Size size = 0; size < 140; ++size) {
+        messages.push(data.data() + size);
+        sizes.push(size);
+    }
+    for (const Size size : { 4096U, 1000U, 5000U, 55U, 56U, 64U }) {
+        messages.push(data.data());
+        sizes.push(size);
+    }
+
+    ByteBuffer digests(messages.size() * Sha256Batch::DIGEST_SIZE);
+    Sha256Batch::hash(messages.data(), sizes.data(), messages.size(), digests.data(), GetParam());
+
+    for (Size i = 0; i < messages.size(); ++i) {
+        Sha256 sha256;
+        sha256.update(messages[i], sizes[i]);
+        ByteBuffer expected(Sha256::DIGEST_SIZE);
+        sha256.finalize(expected);
+
+        const BufferSlice<Byte> digest(digests.data() + i * Sha256Batch::DIGEST_SIZE,
+                                       digests.data() + (i + 1) * Sha256Batch::DIGEST_SIZE);
+        EXPECT_TRUE(bufferUtils::equal(expected, digest)) << "message of " << sizes[i] << " bytes";
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Sha256Batch,
+                         Sha256BatchTest,
+                         testing::Values(Sha256Batch::Implementation::Serial,
+                                         Sha256Batch::Implementation::Avx2,
+                                         Sha256Batch::Implementation::Avx512));
+
+TEST(Sha256BatchTest, buffers) {
+    const String messages[] = { String(""), String("abc"),
+                                String("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq") };
+    ByteBuffer digests(3 * Sha256Batch::DIGEST_SIZE);
+    Sha256Batch::hash(messages, digests);
+
+    ByteBuffer expected;
+    expected << Hex::decode("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    expected << Hex::decode("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    expected << Hex::decode("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+    EXPECT_TRUE(bufferUtils::equal(expected, digests));
+}
+
+TEST(Sha256BatchTest, unsupportedImplementationThrows) {
+    const Byte message[] = { 0x61 };
+    const Byte* const messages[] = { message };
+    const Size sizes[] = { 1 };
+    Byte digest[Sha256Batch::DIGEST_SIZE];
+    for (const auto implementation : { Sha256Batch::Implementation::Serial,
+                                       Sha256Batch::Implementation::Avx2,
+                                       Sha256Batch::Implementation::Avx512 }) {
+        if (Sha256Batch::isSupported(implementation)) {
+            EXPECT_NO_THROW(Sha256Batch::hash(messages, sizes, 1, digest, implementation));
+        } else {
+            EXPECT_THROW(Sha256Batch::hash(messages, sizes, 1, digest, implementation), Exception);
+        }
+    }
+}
+
+} // namespace crypto
@@ -96,6 +96,31 @@ TEST(Sha256Test, reset) {
         Hex::decode("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"), digest));
 }
 
+TEST(Sha256Test, chunked) {
+    ByteBuffer message;
+    for (Size i = 0; i < 1000; ++i) {
+        message.push(Byte(i));
+    }
+
+    Sha256 oneShot;
+    oneShot.update(message);
+    StaticBuffer<Byte, Sha256::DIGEST_SIZE> expected(Sha256::DIGEST_SIZE);
+    oneShot.finalize(expected);
+
+    // Chunks that start and end both on and off the block boundaries
+    Sha256 sha256;
+    Size offset = 0;
+    for (const Size chunk : { 1U, 63U, 64U, 65U, 0U, 127U, 128U, 200U }) {
+        sha256.update(message.data() + offset, chunk);
+        offset += chunk;
+    }
+    sha256.update(message.data() + offset, message.size() - offset);
+
+    StaticBuffer<Byte, Sha256::DIGEST_SIZE> digest(Sha256::DIGEST_SIZE);
+    sha256.finalize(digest);
+    EXPECT_TRUE(bufferUtils::equal(expected, digest));
+}
+
 TEST(Sha256Test, move) {
     Sha256 sha256;
     sha256.update(String("abc"));
@@ -107,4 +132,40 @@ TEST(Sha256Test, move) {
         Hex::decode("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"), digest));
 }
 
+class Sha256ImplementationTest : public testing::TestWithParam<sha::Implementation> {
+public:
+    void SetUp() override {
+        if (!sha::isSupported(GetParam())) {
+            GTEST_SKIP();
+        }
+    }
+};
+
+TEST_P(Sha256ImplementationTest, processBlocks) {
+    // "abc" padded to a single block, followed by the two blocks of case2
+    ByteBuffer blocks;
+    blocks << Hex::decode("61626380000000000000000000000000000000000000000000000000000000000000000000000000"
+                          "000000000000000000000000000000000000000000000018");
+    const String message("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq");
+    blocks.insert(blocks.end(), message.begin(), message.end());
+    blocks.push(0x80);
+    blocks.insert(blocks.end(), 0x00, 3 * Sha256::BLOCK_SIZE - blocks.size() - 2);
+    blocks.push(0x01);
+    blocks.push(0xc0);
+
+    sha::State<sha::Family::SHA256> state;
+    Sha256::processBlocks(state, blocks.data(), 1, GetParam());
+    EXPECT_EQ(0xba7816bfU, state[0]);
+    EXPECT_EQ(0xf20015adU, state[7]);
+
+    state.reset();
+    Sha256::processBlocks(state, blocks.data() + Sha256::BLOCK_SIZE, 2, GetParam());
+    EXPECT_EQ(0x248d6a61U, state[0]);
+    EXPECT_EQ(0x19db06c1U, state[7]);
+}
+
+INSTANTIATE_TEST_SUITE_P(Sha256,
+                         Sha256ImplementationTest,
+                         testing::Values(sha::Implementation::Portable, sha::Implementation::ShaNi));
+
 } // namespace crypto
@@ -0,0 +1,89 @@
+#include "gtest/gtest.h"
+
+#include "cpplibcrypto/buffer/StaticBuffer.h"
+#include "cpplibcrypto/buffer/String.h"
+#include "cpplibcrypto/buffer/utils/bufferUtils.h"
+#include "cpplibcrypto/common/Hex.h"
+#include "cpplibcrypto/hash/Sha2.h"
+
+namespace crypto {
+
+TEST(Sha384Test, empty) {
+    Sha384 sha384;
+    sha384.update(String(""));
+
+    StaticBuffer<Byte, Sha384::DIGEST_SIZE> digest(Sha384::DIGEST_SIZE);
+    sha384.finalize(digest);
+
+    const auto expected = Hex::decode("38b060a751ac96384cd9327eb1b1e36a21fdb71114be07434c0cc7bf63f6e1da"
+                                      "274edebfe76f65fbd51ad2f14898b95b");
+    EXPECT_TRUE(bufferUtils::equal(expected, digest));
+}
+
+TEST(Sha384Test, case1) {
+    Sha384 sha384;
+    sha384.update(String("abc"));
+
+    StaticBuffer<Byte, Sha384::DIGEST_SIZE> digest(Sha384::DIGEST_SIZE);
+    sha384.finalize(digest);
+
+    const auto expected = Hex::decode("cb00753f45a35e8bb5a03d699ac65007272c32ab0eded1631a8b605a43ff5bed"
+                                      "8086072ba1e7cc2358baeca134c825a7");
+    EXPECT_TRUE(bufferUtils::equal(expected, digest));
+}
+
+TEST(Sha384Test, case2) {
+    Sha384 sha384;
+    sha384.update(String("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"));
+
+    StaticBuffer<Byte, Sha384::DIGEST_SIZE> digest(Sha384::DIGEST_SIZE);
+    sha384.finalize(digest);
+
+    const auto expected = Hex::decode("3391fdddfc8dc7393707a65b1b4709397cf8b1d162af05abfe8f450de5f36bc6"
+                                      "b0455a8520bc4e6f5fe95b1fe3c8452b");
+    EXPECT_TRUE(bufferUtils::equal(expected, digest));
+}
+
+TEST(Sha384Test, case3) {
+    Sha384 sha384;
+    sha384.update(String("abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmn"));
+    sha384.update(String("hijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu"));
+
+    StaticBuffer<Byte, Sha384::DIGEST_SIZE> digest(Sha384::DIGEST_SIZE);
+    sha384.finalize(digest);
+
+    const auto expected = Hex::decode("09330c33f71147e83d192fc782cd1b4753111b173b3b05d22fa08086e3b0f712"
+                                      "fcc7c71a557e2db966c3e9fa91746039");
+    EXPECT_TRUE(bufferUtils::equal(expected, digest));
+}
+
+TEST(Sha384Test, case4) {
+    Sha384 sha384;
+    DynamicBuffer<Byte> buffer;
+    buffer.insert(buffer.end(), 0x61, 1000'000U);
+    sha384.update(buffer);
+
+    StaticBuffer<Byte, Sha384::DIGEST_SIZE> digest(Sha384::DIGEST_SIZE);
+    sha384.finalize(digest);
+
+    const auto expected = Hex::decode("9d0e1809716474cb086e834e310a4a1ced149e9c00f248527972cec5704c2a5b"
+                                      "07b8b3dc38ecc4ebae97ddd87f3d8985");
+    EXPECT_TRUE(bufferUtils::equal(expected, digest));
+}
+
+TEST(Sha384Test, reset) {
+    Sha384 sha384;
+    sha384.update(String("abc"));
+    StaticBuffer<Byte, Sha384::DIGEST_SIZE> digest(Sha384::DIGEST_SIZE);
+    sha384.finalize(digest);
+    const auto expected = Hex::decode("cb00753f45a35e8bb5a03d699ac65007272c32ab0eded1631a8b605a43ff5bed"
+                                      "8086072ba1e7cc2358baeca134c825a7");
+    EXPECT_TRUE(bufferUtils::equal(expected, digest));
+
+    sha384.reset();
+    sha384.update(String("abc"));
+    sha384.finalize(digest);
+    EXPECT_TRUE(bufferUtils::equal(expected, digest));
+}
+
+} // namespace crypto
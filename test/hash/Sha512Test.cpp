@@ -0,0 +1,200 @@
+#include "gtest/gtest.h"
+
+#include "cpplibcrypto/buffer/StaticBuffer.h"
+#include "cpplibcrypto/buffer/String.h"
+#include "cpplibcrypto/buffer/utils/bufferUtils.h"
+#include "cpplibcrypto/common/Hex.h"
+#include "cpplibcrypto/hash/Sha2.h"
+
+namespace crypto {
+
+TEST(Sha512Test, empty) {
+    Sha512 sha512;
+    sha512.update(String(""));
+
+    StaticBuffer<Byte, Sha512::DIGEST_SIZE> digest(Sha512::DIGEST_SIZE);
+    sha512.finalize(digest);
+
+    const auto expected = Hex::decode("cf83e1357eefb8bdf1542850d66d8007d620e4050b5715dc83f4a921d36ce9ce"
+                                      "47d0d13c5d85f2b0ff8318d2877eec2f63b931bd47417a81a538327af927da3e");
+    EXPECT_TRUE(bufferUtils::equal(expected, digest));
+}
+
+TEST(Sha512Test, case1) {
+    Sha512 sha512;
+    sha512.update(String("abc"));
+
+    StaticBuffer<Byte, Sha512::DIGEST_SIZE> digest(Sha512::DIGEST_SIZE);
+    sha512.finalize(digest);
+
+    const auto expected = Hex::decode("ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+                                      "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f");
+    EXPECT_TRUE(bufferUtils::equal(expected, digest));
+}
+
+TEST(Sha512Test, case2) {
+    Sha512 sha512;
+    sha512.update(String("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"));
+
+    StaticBuffer<Byte, Sha512::DIGEST_SIZE> digest(Sha512::DIGEST_SIZE);
+    sha512.finalize(digest);
+
+    const auto expected = Hex::decode("204a8fc6dda82f0a0ced7beb8e08a41657c16ef468b228a8279be331a703c335"
+                                      "96fd15c13b1b07f9aa1d3bea57789ca031ad85c7a71dd70354ec631238ca3445");
+    EXPECT_TRUE(bufferUtils::equal(expected, digest));
+}
+
+TEST(Sha512Test, case3) {
+    Sha512 sha512;
+    sha512.update(String("abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmn"));
+    sha512.update(String("hijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu"));
+
+    StaticBuffer<Byte, Sha512::DIGEST_SIZE> digest(Sha512::DIGEST_SIZE);
+    sha512.finalize(digest);
+
+    const auto expected = Hex::decode("8e959b75dae313da8cf4f72814fc143f8f7779c6eb9f7fa17299aeadb6889018"
+                                      "501d289e4900f7e4331b99dec4b5433ac7d329eeb6dd26545e96e55b874be909");
+    EXPECT_TRUE(bufferUtils::equal(expected, digest));
+}
+
+TEST(Sha512Test, case4) {
+    Sha512 sha512;
+    DynamicBuffer<Byte> buffer;
+    buffer.insert(buffer.end(), 0x61, 1000'000U);
+    sha512.update(buffer);
+
+    StaticBuffer<Byte, Sha512::DIGEST_SIZE> digest(Sha512::DIGEST_SIZE);
+    sha512.finalize(digest);
+
+    const auto expected = Hex::decode("e718483d0ce769644e2e42c7bc15b4638e1f98b13b2044285632a803afa973eb"
+                                      "de0ff244877ea60a4cb0432ce577c31beb009c5c2c49aa2e4eadb217ad8cc09b");
+    EXPECT_TRUE(bufferUtils::equal(expected, digest));
+}
+
+TEST(Sha512Test, reset) {
+    Sha512 sha512;
+    sha512.update(String("abc"));
+    StaticBuffer<Byte, Sha512::DIGEST_SIZE> digest(Sha512::DIGEST_SIZE);
+    sha512.finalize(digest);
+    const auto expected = Hex::decode("ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+                                      "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f");
+    EXPECT_TRUE(bufferUtils::equal(expected, digest));
+
+    sha512.reset();
+    sha512.update(String("abc"));
+    sha512.finalize(digest);
+    EXPECT_TRUE(bufferUtils::equal(expected, digest));
+}
+
+TEST(Sha512Test, move) {
+    Sha512 sha512;
+    sha512.update(String("abc"));
+    StaticBuffer<Byte, Sha512::DIGEST_SIZE> digest(Sha512::DIGEST_SIZE);
+
+    Sha512 sha512other = std::move(sha512);
+    sha512other.finalize(digest);
+    const auto expected = Hex::decode("ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+                                      "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f");
+    EXPECT_TRUE(bufferUtils::equal(expected, digest));
+}
+
+TEST(Sha512t256Test, empty) {
+    Sha512_256 sha512;
+    sha512.update(String(""));
+
+    StaticBuffer<Byte, Sha512_256::DIGEST_SIZE> digest(Sha512_256::DIGEST_SIZE);
+    sha512.finalize(digest);
+
+    const auto expected = Hex::decode("c672b8d1ef56ed28ab87c3622c5114069bdd3ad7b8f9737498d0c01ecef0967a");
+    EXPECT_TRUE(bufferUtils::equal(expected, digest));
+}
+
+TEST(Sha512t256Test, case1) {
+    Sha512_256 sha512;
+    sha512.update(String("abc"));
+
+    StaticBuffer<Byte, Sha512_256::DIGEST_SIZE> digest(Sha512_256::DIGEST_SIZE);
+    sha512.finalize(digest);
+
+    const auto expected = Hex::decode("53048e2681941ef99b2e29b76b4c7dabe4c2d0c634fc6d46e0e2f13107e7af23");
+    EXPECT_TRUE(bufferUtils::equal(expected, digest));
+}
+
+TEST(Sha512t256Test, case2) {
+    Sha512_256 sha512;
+    sha512.update(String("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"));
+
+    StaticBuffer<Byte, Sha512_256::DIGEST_SIZE> digest(Sha512_256::DIGEST_SIZE);
+    sha512.finalize(digest);
+
+    const auto expected = Hex::decode("bde8e1f9f19bb9fd3406c90ec6bc47bd36d8ada9f11880dbc8a22a7078b6a461");
+    EXPECT_TRUE(bufferUtils::equal(expected, digest));
+}
+
+TEST(Sha512t256Test, case3) {
+    Sha512_256 sha512;
+    sha512.update(String("abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmn"));
+    sha512.update(String("hijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu"));
+
+    StaticBuffer<Byte, Sha512_256::DIGEST_SIZE> digest(Sha512_256::DIGEST_SIZE);
+    sha512.finalize(digest);
+
+    const auto expected = Hex::decode("3928e184fb8690f840da3988121d31be65cb9d3ef83ee6146feac861e19b563a");
+    EXPECT_TRUE(bufferUtils::equal(expected, digest));
+}
+
+TEST(Sha512t256Test, case4) {
+    Sha512_256 sha512;
+    DynamicBuffer<Byte> buffer;
+    buffer.insert(buffer.end(), 0x61, 1000'000U);
+    sha512.update(buffer);
+
+    StaticBuffer<Byte, Sha512_256::DIGEST_SIZE> digest(Sha512_256::DIGEST_SIZE);
+    sha512.finalize(digest);
+
+    const auto expected = Hex::decode("9a59a052930187a97038cae692f30708aa6491923ef5194394dc68d56c74fb21");
+    EXPECT_TRUE(bufferUtils::equal(expected, digest));
+}
+
+class Sha512ImplementationTest : public testing::TestWithParam<sha::Implementation> {
+public:
+    void SetUp() override {
+        if (!sha::isSupported(GetParam())) {
+            GTEST_SKIP();
+        }
+    }
+};
+
+TEST_P(Sha512ImplementationTest, processBlocks) {
+    // "abc" padded to a single block, followed by the two blocks of case3
+    ByteBuffer blocks;
+    blocks.push(0x61);
+    blocks.push(0x62);
+    blocks.push(0x63);
+    blocks.push(0x80);
+    blocks.insert(blocks.end(), 0x00, Sha512::BLOCK_SIZE - blocks.size() - 1);
+    blocks.push(0x18);
+    const String message("abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmn"
+                         "hijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu");
+    blocks.insert(blocks.end(), message.begin(), message.end());
+    blocks.push(0x80);
+    blocks.insert(blocks.end(), 0x00, 3 * Sha512::BLOCK_SIZE - blocks.size() - 2);
+    blocks.push(0x03);
+    blocks.push(0x80);
+
+    sha::State<sha::Family::SHA512> state;
+    Sha512::processBlocks(state, blocks.data(), 1, GetParam());
+    EXPECT_EQ(0xddaf35a193617abaULL, state[0]);
+    EXPECT_EQ(0x2a9ac94fa54ca49fULL, state[7]);
+
+    state.reset();
+    Sha512::processBlocks(state, blocks.data() + Sha512::BLOCK_SIZE, 2, GetParam());
+    EXPECT_EQ(0x8e959b75dae313daULL, state[0]);
+    EXPECT_EQ(0x5e96e55b874be909ULL, state[7]);
+}
+
+INSTANTIATE_TEST_SUITE_P(Sha512,
+                         Sha512ImplementationTest,
+                         testing::Values(sha::Implementation::Portable, sha::Implementation::Avx2));
+
+} // namespace crypto
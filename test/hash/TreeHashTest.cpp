@@ -0,0 +1,177 @@
+#include "gtest/gtest.h"
+
+#include "cpplibcrypto/buffer/DynamicBuffer.h"
+#include "cpplibcrypto/buffer/StaticBuffer.h"
+#include "cpplibcrypto/buffer/String.h"
+#include "cpplibcrypto/buffer/utils/bufferUtils.h"
+#include "cpplibcrypto/common/Hex.h"
+#include "cpplibcrypto/hash/Sha1.h"
+#include "cpplibcrypto/hash/Sha2.h"
+#include "cpplibcrypto/hash/TreeHash.h"
+#include "cpplibcrypto/io/Stream.h"
+
+namespace crypto {
+
+namespace {
+
+    using Digest = StaticBuffer<Byte, Sha256::DIGEST_SIZE>;
+
+    constexpr Size leafSize = 100;
+
+    ByteBuffer makeData(const Size size) {
+        ByteBuffer data(size);
+        for (Size i = 0; i < size; ++i) {
+            data[i] = static_cast<Byte>(i * 7 + (i >> 8));
+        }
+        return data;
+    }
+
+    Digest sha256(const Byte prefix, const Byte* data, const Size size) {
+        Sha256 sha;
+        sha.update(&prefix, 1);
+        sha.update(data, size);
+        Digest digest(Sha256::DIGEST_SIZE);
+        sha.finalize(digest);
+        return digest;
+    }
+
+    Digest node(const Digest& left, const Digest& right) {
+        ByteBuffer children;
+        children.insert(children.end(), left.begin(), left.end());
+        children.insert(children.end(), right.begin(), right.end());
+        return sha256(0x01, children.data(), children.size());
+    }
+
+    Digest treeHash(const ByteBuffer& data, const Size threadCount = 1) {
+        TreeHash<Sha256> tree(leafSize);
+        tree.setThreadCount(threadCount);
+        tree.update(data);
+        Digest root(Sha256::DIGEST_SIZE);
+        tree.finalize(root);
+        return root;
+    }
+
+} // namespace
+
+TEST(TreeHashTest, empty) {
+    TreeHash<Sha256> tree;
+    tree.update(String(""));
+    Digest root(Sha256::DIGEST_SIZE);
+    tree.finalize(root);
+
+    // SHA-256 of the single byte 0x00
+    EXPECT_TRUE(bufferUtils::equal(
+        Hex::decode("6e340b9cffb37a989ca544e6bb780a2c78901d3fb33738768511a30617afa01d"), root));
+    EXPECT_EQ(1U, tree.getLeafCount());
+}
+
+TEST(TreeHashTest, singleLeaf) {
+    const ByteBuffer data = makeData(leafSize);
+    EXPECT_TRUE(bufferUtils::equal(sha256(0x00, data.data(), data.size()), treeHash(data)));
+}
+
+TEST(TreeHashTest, structure) {
+    // Five leaves, the last one partial: ((l0 l1) (l2 l3)) l4
+    const ByteBuffer data = makeData(4 * leafSize + 30);
+    Digest leaves[5];
+    for (Size i = 0; i < 5; ++i) {
+        leaves[i] = sha256(0x00, data.data() + i * leafSize, std::min(leafSize, data.size() - i * leafSize));
+    }
+    const Digest expected = node(node(node(leaves[0], leaves[1]), node(leaves[2], leaves[3])), leaves[4]);
+    EXPECT_TRUE(bufferUtils::equal(expected, treeHash(data)));
+}
+
+TEST(TreeHashTest, streamingMatchesOneShot) {
+    const ByteBuffer data = makeData(leafSize * 37 + 11);
+    const Digest expected = treeHash(data);
+
+    // Pieces smaller and larger than a leaf
+    TreeHash<Sha256> pieces(leafSize);
+    pieces.setThreadCount(3);
+    for (Size offset = 0, piece = 1; offset < data.size(); offset += piece, piece = piece * 3 % 517 + 1) {
+        pieces.update(data.data() + offset, std::min(piece, data.size() - offset));
+    }
+    Digest root(Sha256::DIGEST_SIZE);
+    pieces.finalize(root);
+    EXPECT_TRUE(bufferUtils::equal(expected, root));
+
+    TreeHash<Sha256> stream(leafSize);
+    stream.setThreadCount(2);
+    StringInputStream input(String(data.begin(), data.end()));
+    stream.update(input);
+    stream.finalize(root);
+    EXPECT_TRUE(bufferUtils::equal(expected, root));
+}
+
+TEST(TreeHashTest, parallelMatchesSerial) {
+    for (const Size size : { Size(0), leafSize - 1, leafSize * 64, leafSize * 200 + 1 }) {
+        const ByteBuffer data = makeData(size);
+        EXPECT_TRUE(bufferUtils::equal(treeHash(data), treeHash(data, 4))) << size;
+    }
+}
+
+TEST(TreeHashTest, lowerThreadCountBetweenUpdates) {
+    const ByteBuffer data = makeData(leafSize * 60 + 30);
+    const Digest expected = treeHash(data);
+
+    // The data buffered with 4 threads is larger than the batch for 1 thread
+    for (const bool fromStream : { false, true }) {
+        TreeHash<Sha256> tree(leafSize);
+        tree.setThreadCount(4);
+        tree.update(data.data(), 10);
+        tree.update(data.data() + 10, 630);
+        tree.setThreadCount(1);
+        const BufferSlice<const Byte> rest(data.data() + 640, data.data() + data.size());
+        if (fromStream) {
+            StringInputStream input(String(rest.begin(), rest.end()));
+            tree.update(input);
+        } else {
+            tree.update(rest);
+        }
+        Digest root(Sha256::DIGEST_SIZE);
+        tree.finalize(root);
+        EXPECT_TRUE(bufferUtils::equal(expected, root)) << fromStream;
+    }
+}
+
+TEST(TreeHashTest, locateCorruptedLeaf) {
+    ByteBuffer data = makeData(leafSize * 10);
+    TreeHash<Sha256> tree(leafSize);
+    tree.update(data);
+    Digest root(Sha256::DIGEST_SIZE);
+    tree.finalize(root);
+    ASSERT_EQ(10U, tree.getLeafCount());
+
+    // The root can be recomputed from the stored leaf digests alone
+    Digest recomputed(Sha256::DIGEST_SIZE);
+    TreeHash<Sha256>::computeRoot(tree.getLeafDigests().data(), tree.getLeafCount(), recomputed);
+    EXPECT_TRUE(bufferUtils::equal(root, recomputed));
+
+    data[6 * leafSize + 42] ^= 0x01;
+    for (Size leaf = 0; leaf < 10; ++leaf) {
+        const Byte* leafData = data.data() + leaf * leafSize;
+        Digest digest(Sha256::DIGEST_SIZE);
+        TreeHash<Sha256>::hashLeaf(BufferSlice<const Byte>(leafData, leafData + leafSize), digest);
+        const bool intact = std::equal(digest.begin(), digest.end(),
+                                       tree.getLeafDigests().data() + leaf * Sha256::DIGEST_SIZE);
+        EXPECT_EQ(leaf != 6, intact) << leaf;
+    }
+}
+
+TEST(TreeHashTest, finalizeTwiceThrows) {
+    TreeHash<Sha1> tree(leafSize);
+    tree.update(makeData(250));
+    StaticBuffer<Byte, Sha1::DIGEST_SIZE> root(Sha1::DIGEST_SIZE);
+    tree.finalize(root);
+    EXPECT_EQ(3U, tree.getLeafCount());
+    EXPECT_THROW(tree.finalize(root), Exception);
+    EXPECT_THROW(tree.update(makeData(1)), Exception);
+
+    StaticBuffer<Byte, Sha1::DIGEST_SIZE> again(Sha1::DIGEST_SIZE);
+    tree.reset();
+    tree.update(makeData(250));
+    tree.finalize(again);
+    EXPECT_TRUE(bufferUtils::equal(root, again));
+}
+
+} // namespace crypto
@@ -0,0 +1,160 @@
+#include "gtest/gtest.h"
+
+#include "cpplibcrypto/buffer/DynamicBuffer.h"
+#include "cpplibcrypto/buffer/utils/bufferUtils.h"
+#include "cpplibcrypto/io/AsyncFileStream.h"
+#include "cpplibcrypto/io/Stream.h"
+
+#include <cstdio>
+#include <string>
+
+#include <unistd.h>
+
+namespace crypto {
+
+namespace {
+
+    class AsyncFileStreamTest : public testing::TestWithParam<bool> {
+    protected:
+        void SetUp() override {
+            if (!AsyncFileInputStream::isSupported()) {
+                GTEST_SKIP() << "io_uring not supported";
+            }
+            mFileName = String(testing::TempDir().c_str()) + "async-stream.bin";
+            mOptions.bufferCount = 3;
+            mOptions.bufferSize = 4096;
+            mOptions.direct = GetParam();
+        }
+
+        void TearDown() override { std::remove(mFileName.c_str()); }
+
+        /// Writes the data in pieces of odd sizes, so they straddle the buffers
+        void writeData(const ByteBuffer& data, const AsyncFileOutputStream::OpenMode mode) {
+            AsyncFileOutputStream output(mFileName, mode, mOptions);
+            for (Size offset = 0; offset < data.size();) {
+                const Size size = std::min<Size>(1000 + offset % 3001, data.size() - offset);
+                output.write(data.data() + offset, size);
+                offset += size;
+            }
+            output.close();
+        }
+
+        ByteBuffer readAll() {
+            FileInputStream input(mFileName);
+            ByteBuffer data;
+            Byte chunk[4096];
+            while (!input.eof()) {
+                const Size read = input.read(chunk, sizeof(chunk));
+                data.insert(data.end(), chunk, chunk + read);
+            }
+            return data;
+        }
+
+        String mFileName;
+        AsyncFileOptions mOptions;
+    };
+
+    ByteBuffer makeData(const Size size, const Byte seed) {
+        ByteBuffer data(size);
+        for (Size i = 0; i < size; ++i) {
+            data[i] = static_cast<Byte>(i * 13 + (i >> 9) + seed);
+        }
+        return data;
+    }
+
+} // namespace
+
+TEST_P(AsyncFileStreamTest, writeThenRead) {
+    const ByteBuffer data = makeData(100003, 1);
+    writeData(data, AsyncFileOutputStream::OpenMode::OVERWRITE);
+    EXPECT_TRUE(bufferUtils::equal(data, readAll()));
+
+    AsyncFileInputStream input(mFileName, mOptions);
+    EXPECT_EQ(data.size(), input.getSize());
+    ByteBuffer read(data.size());
+    Size done = 0;
+    while (!input.eof()) {
+        done += input.read(read.data() + done, std::min<Size>(777, read.size() - done));
+    }
+    EXPECT_EQ(data.size(), done);
+    EXPECT_TRUE(bufferUtils::equal(data, read));
+    EXPECT_EQ(0U, input.read(read.data(), 1));
+}
+
+TEST_P(AsyncFileStreamTest, nextWindows) {
+    const ByteBuffer data = makeData(50000, 2);
+    writeData(data, AsyncFileOutputStream::OpenMode::OVERWRITE);
+
+    AsyncFileInputStream input(mFileName, mOptions);
+    ByteBuffer read;
+    while (!input.eof()) {
+        const BufferSlice<const Byte> window = input.next();
+        EXPECT_FALSE(window.empty());
+        EXPECT_LE(window.size(), 4096U);
+        read.insert(read.end(), window.begin(), window.end());
+    }
+    EXPECT_TRUE(input.next().empty());
+    EXPECT_TRUE(bufferUtils::equal(data, read));
+}
+
+TEST_P(AsyncFileStreamTest, append) {
+    const ByteBuffer first = makeData(5000, 3);
+    const ByteBuffer second = makeData(9000, 4);
+    writeData(first, AsyncFileOutputStream::OpenMode::OVERWRITE);
+    writeData(second, AsyncFileOutputStream::OpenMode::APPEND);
+
+    ByteBuffer expected;
+    expected.insert(expected.end(), first.begin(), first.end());
+    expected.insert(expected.end(), second.begin(), second.end());
+    EXPECT_TRUE(bufferUtils::equal(expected, readAll()));
+}
+
+TEST_P(AsyncFileStreamTest, flush) {
+    const ByteBuffer data = makeData(10000, 5);
+    AsyncFileOutputStream output(mFileName, AsyncFileOutputStream::OpenMode::OVERWRITE, mOptions);
+    output.write(data.data(), data.size());
+    output.flush();
+    if (!output.isDirect()) {
+        EXPECT_TRUE(bufferUtils::equal(data, readAll()));
+    }
+    output.write(data.data(), data.size());
+    output.close();
+
+    ByteBuffer expected;
+    expected.insert(expected.end(), data.begin(), data.end());
+    expected.insert(expected.end(), data.begin(), data.end());
+    EXPECT_TRUE(bufferUtils::equal(expected, readAll()));
+}
+
+TEST_P(AsyncFileStreamTest, emptyFile) {
+    writeData(ByteBuffer(), AsyncFileOutputStream::OpenMode::OVERWRITE);
+    AsyncFileInputStream input(mFileName, mOptions);
+    EXPECT_TRUE(input.eof());
+    EXPECT_TRUE(input.next().empty());
+}
+
+INSTANTIATE_TEST_SUITE_P(Io, AsyncFileStreamTest, testing::Values(false, true));
+
+TEST(AsyncFileStreamTest, missingFile) {
+    if (!AsyncFileInputStream::isSupported()) {
+        GTEST_SKIP() << "io_uring not supported";
+    }
+    EXPECT_THROW(AsyncFileInputStream("/nonexistent/cpplibcrypto-async.bin"), Exception);
+}
+
+TEST(AsyncFileStreamTest, notRegularFile) {
+    if (!AsyncFileInputStream::isSupported()) {
+        GTEST_SKIP() << "io_uring not supported";
+    }
+    // Reports a size of 0, reading it would give empty input instead of the data
+    EXPECT_THROW(AsyncFileInputStream("/dev/zero"), Exception);
+
+    int fds[2];
+    ASSERT_EQ(0, ::pipe(fds));
+    const String pipeName = String("/dev/fd/") + std::to_string(fds[0]).c_str();
+    EXPECT_THROW(AsyncFileInputStream{ pipeName }, Exception);
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+} // namespace crypto
@@ -0,0 +1,190 @@
+#include "gtest/gtest.h"
+
+#include "cpplibcrypto/buffer/DynamicBuffer.h"
+#include "cpplibcrypto/buffer/HexString.h"
+#include "cpplibcrypto/buffer/utils/bufferUtils.h"
+#include "cpplibcrypto/cipher/Aes.h"
+#include "cpplibcrypto/cipher/AesIv.h"
+#include "cpplibcrypto/cipher/CtrMode.h"
+#include "cpplibcrypto/io/ChunkedContainer.h"
+#include "cpplibcrypto/io/Stream.h"
+
+#include <utility>
+
+namespace crypto {
+
+namespace {
+
+    const AesKey key(HexString("2b7e151628aed2a6abf7158809cf4f3c"));
+    const Byte nonce[ChunkedContainer::NONCE_SIZE] = { 0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7 };
+    constexpr Size chunkSize = 256;
+    constexpr Size recordSize = chunkSize + ChunkedContainer::TAG_SIZE;
+
+    HmacKey macKey() { return HmacKey(HexString("000102030405060708090a0b0c0d0e0f")); }
+
+    String makeData(const Size size) {
+        String data;
+        for (Size i = 0; i < size; ++i) {
+            data += static_cast<char>(i * 31 + (i >> 7));
+        }
+        return data;
+    }
+
+    ByteBuffer toBuffer(const String& string) {
+        ByteBuffer buffer;
+        buffer.insert(buffer.end(), string.begin(), string.end());
+        return buffer;
+    }
+
+    String encode(const String& data, const Size threadCount = 1) {
+        const BufferSlice<const Byte> nonceSlice(nonce, nonce + sizeof(nonce));
+        ChunkedEncoder encoder(key, macKey(), nonceSlice, chunkSize);
+        encoder.setThreadCount(threadCount);
+        StringInputStream input(data);
+        StringOutputStream output;
+        const Qword written = encoder.encode(input, output);
+        EXPECT_EQ(output.toString().size(), written);
+        return output.toString();
+    }
+
+    String decode(const String& container, const Size threadCount = 1) {
+        ChunkedDecoder decoder(key, macKey());
+        decoder.setThreadCount(threadCount);
+        StringInputStream input(container);
+        StringOutputStream output;
+        const Qword written = decoder.decode(input, output);
+        EXPECT_EQ(output.toString().size(), written);
+        return output.toString();
+    }
+
+} // namespace
+
+TEST(ChunkedContainerTest, roundTrip) {
+    // Empty, partial chunks and exact multiples of the chunk size, which end with an empty chunk
+    for (const Size size : { 0, 1, 100, 256, 257, 1000, 1024, 5000 }) {
+        const String data = makeData(size);
+        const String container = encode(data);
+        const Size chunks = size / chunkSize + 1;
+        EXPECT_EQ(ChunkedContainer::HEADER_SIZE + size + chunks * ChunkedContainer::TAG_SIZE,
+                  container.size());
+        const ByteBuffer buffer = toBuffer(container);
+        EXPECT_EQ(size, ChunkedContainer::getPlaintextSize(buffer));
+        EXPECT_EQ(data, decode(container)) << size;
+    }
+}
+
+TEST(ChunkedContainerTest, chunkIsCtrWithChunkCounter) {
+    const String data = makeData(600);
+    const ByteBuffer container = toBuffer(encode(data));
+
+    // Chunk 1 uses the counter block nonce || 1 || 0
+    ByteBuffer counter;
+    counter.insert(counter.end(), nonce, nonce + sizeof(nonce));
+    counter.insert(counter.end(), 0x00, 8);
+    counter[11] = 0x01;
+    const ByteBuffer plaintext = toBuffer(data.substr(chunkSize, chunkSize));
+    ByteBuffer expected;
+    CtrMode<Aes>::Encryption ctr(key, AesIv(std::move(counter)));
+    ctr.update(plaintext, expected);
+
+    const Byte* chunk = container.data() + ChunkedContainer::HEADER_SIZE + recordSize;
+    ByteBuffer actual;
+    actual.insert(actual.end(), chunk, chunk + chunkSize);
+    EXPECT_TRUE(bufferUtils::equal(expected, actual));
+}
+
+TEST(ChunkedContainerTest, parallelMatchesSerial) {
+    // Several batches, the last one partial
+    const String data = makeData(chunkSize * 100 + 17);
+    const String container = encode(data);
+    EXPECT_EQ(container, encode(data, 3));
+    EXPECT_EQ(data, decode(container, 4));
+}
+
+TEST(ChunkedContainerTest, tamperedChunkFails) {
+    const String container = encode(makeData(1000));
+    for (const Size position : { Size(5), ChunkedContainer::HEADER_SIZE + 10, container.size() - 1 }) {
+        String tampered = container;
+        tampered[position] ^= 0x01;
+        EXPECT_THROW(decode(tampered), Exception) << position;
+    }
+}
+
+TEST(ChunkedContainerTest, truncatedContainerFails) {
+    const String container = encode(makeData(1000));
+    // Cut off inside the last chunk, after the last full chunk and inside the header
+    for (const Size size : { container.size() - 1,
+                             ChunkedContainer::HEADER_SIZE + 3 * recordSize,
+                             ChunkedContainer::HEADER_SIZE - 1 }) {
+        EXPECT_THROW(decode(container.substr(0, size)), Exception) << size;
+    }
+}
+
+TEST(ChunkedContainerTest, reorderedChunksFail) {
+    String container = encode(makeData(1000));
+    const Size first = ChunkedContainer::HEADER_SIZE;
+    const String chunk = container.substr(first, recordSize);
+    container.replace(first, recordSize, container.substr(first + recordSize, recordSize));
+    container.replace(first + recordSize, recordSize, chunk);
+    EXPECT_THROW(decode(container), Exception);
+}
+
+TEST(ChunkedContainerTest, wrongKeyFails) {
+    const String container = encode(makeData(100));
+    ChunkedDecoder decoder(key, HmacKey(HexString("00")));
+    StringInputStream input(container);
+    StringOutputStream output;
+    EXPECT_THROW(decoder.decode(input, output), Exception);
+    EXPECT_TRUE(output.toString().empty());
+}
+
+TEST(ChunkedContainerTest, decodeRange) {
+    const String data = makeData(1000);
+    const ByteBuffer container = toBuffer(encode(data));
+    ChunkedDecoder decoder(key, macKey());
+    decoder.setThreadCount(2);
+
+    const std::pair<Size, Size> ranges[] = {
+        { 0, 1000 }, { 0, 1 }, { 255, 2 }, { 300, 500 }, { 999, 1 }, { 1000, 0 }
+    };
+    for (const auto& range : ranges) {
+        ByteBuffer out;
+        out.push(0xaa);
+        decoder.decodeRange(container, range.first, range.second, out);
+        ASSERT_EQ(range.second + 1, out.size());
+        EXPECT_EQ(0xaa, out[0]);
+        EXPECT_EQ(data.substr(range.first, range.second), String(out.begin() + 1, out.end())) << range.first;
+    }
+
+    ByteBuffer out;
+    EXPECT_THROW(decoder.decodeRange(container, 990, 11, out), Exception);
+    EXPECT_THROW(decoder.decodeRange(container, 1001, 0, out), Exception);
+}
+
+TEST(ChunkedContainerTest, decodeRangeVerifiesOnlyCoveredChunks) {
+    ByteBuffer container = toBuffer(encode(makeData(1000)));
+    // Damage chunk 2
+    container[ChunkedContainer::HEADER_SIZE + 2 * recordSize + 7] ^= 0x80;
+    ChunkedDecoder decoder(key, macKey());
+
+    ByteBuffer out;
+    decoder.decodeRange(container, 0, 2 * chunkSize, out);
+    EXPECT_EQ(2 * chunkSize, out.size());
+
+    out.clear();
+    EXPECT_THROW(decoder.decodeRange(container, 2 * chunkSize - 1, 2, out), Exception);
+    EXPECT_TRUE(out.empty());
+}
+
+TEST(ChunkedContainerTest, invalidParameters) {
+    const BufferSlice<const Byte> shortNonce(nonce, nonce + 4);
+    EXPECT_THROW(ChunkedEncoder(key, macKey(), shortNonce), Exception);
+    const BufferSlice<const Byte> validNonce(nonce, nonce + sizeof(nonce));
+    EXPECT_THROW(ChunkedEncoder(key, macKey(), validNonce, 0), Exception);
+
+    String container = encode(makeData(10));
+    container[0] = 'X';
+    EXPECT_THROW(decode(container), Exception);
+}
+
+} // namespace crypto
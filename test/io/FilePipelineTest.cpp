@@ -0,0 +1,120 @@
+#include "gtest/gtest.h"
+
+#include "cpplibcrypto/buffer/DynamicBuffer.h"
+#include "cpplibcrypto/buffer/HexString.h"
+#include "cpplibcrypto/buffer/utils/bufferUtils.h"
+#include "cpplibcrypto/cipher/Aes.h"
+#include "cpplibcrypto/cipher/AesIv.h"
+#include "cpplibcrypto/cipher/CbcMode.h"
+#include "cpplibcrypto/cipher/CtrMode.h"
+#include "cpplibcrypto/io/FilePipeline.h"
+#include "cpplibcrypto/io/Stream.h"
+#include "cpplibcrypto/padding/Pkcs7.h"
+
+#include <cstring>
+
+namespace crypto {
+
+namespace {
+
+    const AesKey key(HexString("2b7e151628aed2a6abf7158809cf4f3c"));
+    const char* ivHex = "000102030405060708090a0b0c0d0e0f";
+
+    String makeData(const Size size) {
+        String data;
+        for (Size i = 0; i < size; ++i) {
+            data += static_cast<char>(i * 31 + (i >> 7));
+        }
+        return data;
+    }
+
+    ByteBuffer toBuffer(const String& string) {
+        ByteBuffer buffer;
+        buffer.insert(buffer.end(), string.begin(), string.end());
+        return buffer;
+    }
+
+    /// Fails after the given number of bytes
+    class FailingInputStream : public InputStream {
+    public:
+        Size read(void* output, const Size count) override {
+            if (mRead + count > 1000) {
+                throw Exception("read failed");
+            }
+            std::memset(output, 0, count);
+            mRead += count;
+            return count;
+        }
+
+        bool eof() const override { return false; }
+
+        void close() override {}
+
+    private:
+        Size mRead = 0;
+    };
+
+} // namespace
+
+TEST(FilePipelineTest, cbcMatchesSerial) {
+    const String data = makeData(10000);
+
+    const ByteBuffer plaintext = toBuffer(data);
+    ByteBuffer expected;
+    CbcMode<Aes>::Encryption serial(key, AesIv(HexString(ivHex)));
+    serial.update(plaintext, expected);
+    serial.finalize(expected, Pkcs7());
+
+    StringInputStream input(data);
+    StringOutputStream output;
+    CbcMode<Aes>::Encryption encryptor(key, AesIv(HexString(ivHex)));
+    const Size written = FilePipeline(256, 3).run(input, encryptor, output, Pkcs7());
+    EXPECT_EQ(expected.size(), written);
+    EXPECT_TRUE(bufferUtils::equal(expected, toBuffer(output.toString())));
+
+    StringInputStream cipherInput(output.toString());
+    StringOutputStream plainOutput;
+    CbcMode<Aes>::Decryption decryptor(key, AesIv(HexString(ivHex)));
+    FilePipeline(100, 2).run(cipherInput, decryptor, plainOutput, Pkcs7());
+    EXPECT_EQ(data, plainOutput.toString());
+}
+
+TEST(FilePipelineTest, ctrWithoutFinalization) {
+    const String data = makeData(4096);
+
+    const ByteBuffer plaintext = toBuffer(data);
+    ByteBuffer expected;
+    CtrMode<Aes>::Encryption serial(key, AesIv(HexString(ivHex)));
+    serial.update(plaintext, expected);
+
+    // The input size is a multiple of the buffer size, the last buffer is read empty
+    StringInputStream input(data);
+    StringOutputStream output;
+    CtrMode<Aes>::Encryption encryptor(key, AesIv(HexString(ivHex)));
+    EXPECT_EQ(data.size(), FilePipeline(1024, 2).run(input, encryptor, output));
+    EXPECT_TRUE(bufferUtils::equal(expected, toBuffer(output.toString())));
+}
+
+TEST(FilePipelineTest, emptyInput) {
+    StringInputStream input;
+    StringOutputStream output;
+    CbcMode<Aes>::Encryption encryptor(key, AesIv(HexString(ivHex)));
+    EXPECT_EQ(16U, FilePipeline(64, 2).run(input, encryptor, output, Pkcs7()));
+}
+
+TEST(FilePipelineTest, readerErrorStopsPipeline) {
+    FailingInputStream input;
+    StringOutputStream output;
+    CtrMode<Aes>::Encryption encryptor(key, AesIv(HexString(ivHex)));
+    EXPECT_THROW(FilePipeline(64, 2).run(input, encryptor, output), Exception);
+}
+
+TEST(FilePipelineTest, cipherErrorStopsPipeline) {
+    // Without padding, the input has to be a multiple of the block size
+    StringInputStream input(makeData(1001));
+    StringOutputStream output;
+    CbcMode<Aes>::Encryption encryptor(key, AesIv(HexString(ivHex)));
+    EXPECT_THROW(FilePipeline(64, 2).run(input, encryptor, output, PaddingNone()), Exception);
+}
+
+} // namespace crypto
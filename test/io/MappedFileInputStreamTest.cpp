@@ -0,0 +1,118 @@
+#include "gtest/gtest.h"
+
+#include "cpplibcrypto/buffer/DynamicBuffer.h"
+#include "cpplibcrypto/buffer/StaticBuffer.h"
+#include "cpplibcrypto/buffer/utils/bufferUtils.h"
+#include "cpplibcrypto/common/Hex.h"
+#include "cpplibcrypto/hash/Sha2.h"
+#include "cpplibcrypto/io/MappedFileInputStream.h"
+#include "cpplibcrypto/io/Stream.h"
+
+#include <cstdio>
+#include <string>
+
+#include <unistd.h>
+
+namespace crypto {
+
+namespace {
+
+    /// Writes the given data to a file in the test temporary directory, removes it when destroyed
+    class TemporaryFile {
+    public:
+        TemporaryFile(const char* name, const ByteBuffer& data)
+            : mName(String(testing::TempDir().c_str()) + name) {
+            FileOutputStream output(mName);
+            output.write(data.data(), data.size());
+        }
+
+        ~TemporaryFile() { std::remove(mName.c_str()); }
+
+        const String& getName() const { return mName; }
+
+    private:
+        String mName;
+    };
+
+    ByteBuffer makeData(const Size size) {
+        ByteBuffer data(size);
+        for (Size i = 0; i < size; ++i) {
+            data[i] = static_cast<Byte>(i * 7 + (i >> 8));
+        }
+        return data;
+    }
+
+} // namespace
+
+TEST(MappedFileInputStreamTest, windowsCoverFile) {
+    const ByteBuffer data = makeData(100000);
+    TemporaryFile file("mapped-windows.bin", data);
+    MappedFileInputStream input(file.getName());
+    EXPECT_EQ(data.size(), input.getSize());
+    EXPECT_TRUE(bufferUtils::equal(data, input.getData()));
+
+    Sha256 expected;
+    expected.update(data);
+    StaticBuffer<Byte, Sha256::DIGEST_SIZE> expectedDigest(Sha256::DIGEST_SIZE);
+    expected.finalize(expectedDigest);
+
+    Sha256 sha;
+    Size windows = 0;
+    while (!input.eof()) {
+        const BufferSlice<const Byte> window = input.next(4096);
+        EXPECT_LE(window.size(), 4096U);
+        sha.update(window);
+        ++windows;
+    }
+    EXPECT_EQ(25U, windows);
+    EXPECT_EQ(data.size(), input.getPosition());
+    EXPECT_TRUE(input.next(4096).empty());
+
+    StaticBuffer<Byte, Sha256::DIGEST_SIZE> digest(Sha256::DIGEST_SIZE);
+    sha.finalize(digest);
+    EXPECT_TRUE(bufferUtils::equal(expectedDigest, digest));
+    input.close();
+    EXPECT_FALSE(input.isOpen());
+}
+
+TEST(MappedFileInputStreamTest, read) {
+    const ByteBuffer data = makeData(1000);
+    TemporaryFile file("mapped-read.bin", data);
+    MappedFileInputStream input(file.getName());
+
+    ByteBuffer out(600);
+    EXPECT_EQ(600U, input.read(out.data(), out.size()));
+    EXPECT_FALSE(input.eof());
+    EXPECT_EQ(400U, input.read(out.data() + 200, 600));
+    EXPECT_TRUE(input.eof());
+    EXPECT_EQ(0U, input.read(out.data(), out.size()));
+    EXPECT_TRUE(bufferUtils::equal(BufferSlice<const Byte>(data.data() + 600, data.data() + 1000),
+                                   BufferSlice<const Byte>(out.data() + 200, out.data() + 600)));
+}
+
+TEST(MappedFileInputStreamTest, emptyFile) {
+    TemporaryFile file("mapped-empty.bin", ByteBuffer());
+    MappedFileInputStream input(file.getName());
+    EXPECT_EQ(0U, input.getSize());
+    EXPECT_TRUE(input.eof());
+    EXPECT_TRUE(input.next(16).empty());
+    EXPECT_TRUE(input.getData().empty());
+}
+
+TEST(MappedFileInputStreamTest, missingFile) {
+    EXPECT_THROW(MappedFileInputStream("/nonexistent/cpplibcrypto-mapped.bin"), Exception);
+}
+
+TEST(MappedFileInputStreamTest, notRegularFile) {
+    // Reports a size of 0, mapping it would give empty input instead of the data
+    EXPECT_THROW(MappedFileInputStream("/dev/zero"), Exception);
+
+    int fds[2];
+    ASSERT_EQ(0, ::pipe(fds));
+    const String pipeName = String("/dev/fd/") + std::to_string(fds[0]).c_str();
+    EXPECT_THROW(MappedFileInputStream{ pipeName }, Exception);
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+} // namespace crypto
@@ -0,0 +1,99 @@
+#include "gtest/gtest.h"
+
+#include "cpplibcrypto/buffer/DynamicBuffer.h"
+#include "cpplibcrypto/buffer/Password.h"
+#include "cpplibcrypto/buffer/Salt.h"
+#include "cpplibcrypto/buffer/String.h"
+#include "cpplibcrypto/buffer/utils/bufferUtils.h"
+#include "cpplibcrypto/common/Exception.h"
+#include "cpplibcrypto/common/Hex.h"
+#include "cpplibcrypto/hash/Sha2.h"
+#include "cpplibcrypto/kdf/Pbkdf.h"
+#include "cpplibcrypto/kdf/Pbkdf2Sha256Batch.h"
+
+namespace crypto {
+
+class Pbkdf2Sha256BatchTest : public testing::TestWithParam<Pbkdf2Sha256Batch::Implementation> {
+public:
+    void SetUp() override {
+        if (!Sha256Batch::isSupported(GetParam())) {
+            GTEST_SKIP();
+        }
+    }
+};
+
+TEST_P(Pbkdf2Sha256BatchTest, matchesPbkdf) {
+    // More pairs than lanes, passwords longer than the HMAC block and a key of two and a half blocks, so the
+    // blocks of one pair end up in different lanes and groups
+    ByteBuffer data;
+    for (Size i = 0; i < 200; ++i) {
+        data.push(Byte(i * 13 + 5));
+    }
+    DynamicBuffer<const Byte*> passwords;
+    DynamicBuffer<Size> passwordSizes;
+    DynamicBuffer<const Byte*> salts;
+    DynamicBuffer<Size> saltSizes;
+    for (Size i = 0; i < 21; ++i) {
+        passwords.push(data.data() + i);
+        passwordSizes.push(i * 7);
+        salts.push(data.data() + 100 + i);
+        saltSizes.push(i * 3 % 70);
+    }
+
+    constexpr Size length = 80;
+    constexpr Size iterations = 3;
+    ByteBuffer keys(passwords.size() * length);
+    Pbkdf2Sha256Batch::derive(passwords.data(), passwordSizes.data(), salts.data(), saltSizes.data(),
+                              passwords.size(), length, iterations, keys.data(), GetParam());
+
+    for (Size i = 0; i < passwords.size(); ++i) {
+        Pbkdf<Sha256> kdf(Password(BufferSlice<const Byte>(passwords[i], passwords[i] + passwordSizes[i])),
+                          Salt(BufferSlice<const Byte>(salts[i], salts[i] + saltSizes[i])));
+        ByteBuffer expected(length);
+        kdf.derive(length, expected, iterations);
+
+        const BufferSlice<Byte> key(keys.data() + i * length, keys.data() + (i + 1) * length);
+        EXPECT_TRUE(bufferUtils::equal(expected, key)) << "pair " << i;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Pbkdf2Sha256Batch,
+                         Pbkdf2Sha256BatchTest,
+                         testing::Values(Pbkdf2Sha256Batch::Implementation::Serial,
+                                         Pbkdf2Sha256Batch::Implementation::Avx2,
+                                         Pbkdf2Sha256Batch::Implementation::Avx512));
+
+TEST(Pbkdf2Sha256BatchTest, buffers) {
+    const Password passwords[] = { Password(String("password")), Password(String("passwd")) };
+    const Salt salts[] = { Salt(String("salt")), Salt(String("salt")) };
+    ByteBuffer keys(2 * 32);
+    Pbkdf2Sha256Batch::derive(passwords, salts, 32, keys, 4096);
+
+    ByteBuffer expected;
+    expected << Hex::decode("c5e478d59288c841aa530db6845c4c8d962893a001ce4e11a4963873aa98134a");
+    expected << Hex::decode("21943fd5b7a10905c38fad60157ff498e1e81df1e03254325682a74dca3b2be8");
+    EXPECT_TRUE(bufferUtils::equal(expected, keys));
+}
+
+TEST(Pbkdf2Sha256BatchTest, unsupportedImplementationThrows) {
+    const Byte password[] = { 0x70 };
+    const Byte salt[] = { 0x73 };
+    const Byte* const passwords[] = { password };
+    const Byte* const salts[] = { salt };
+    const Size sizes[] = { 1 };
+    Byte key[32];
+    const auto derive = [&](const Pbkdf2Sha256Batch::Implementation implementation) {
+        Pbkdf2Sha256Batch::derive(passwords, sizes, salts, sizes, 1, sizeof(key), 2, key, implementation);
+    };
+    for (const auto implementation : { Pbkdf2Sha256Batch::Implementation::Serial,
+                                       Pbkdf2Sha256Batch::Implementation::Avx2,
+                                       Pbkdf2Sha256Batch::Implementation::Avx512 }) {
+        if (Sha256Batch::isSupported(implementation)) {
+            EXPECT_NO_THROW(derive(implementation));
+        } else {
+            EXPECT_THROW(derive(implementation), Exception);
+        }
+    }
+}
+
+} // namespace crypto
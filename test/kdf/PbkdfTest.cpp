@@ -4,6 +4,8 @@
 #include "cpplibcrypto/buffer/String.h"
 #include "cpplibcrypto/buffer/utils/bufferUtils.h"
 #include "cpplibcrypto/common/Hex.h"
+#include "cpplibcrypto/hash/Md5.h"
+#include "cpplibcrypto/hash/Sha2.h"
 #include "cpplibcrypto/kdf/Pbkdf.h"
 
 namespace crypto {
@@ -89,4 +91,58 @@ TEST(Pbkdf2Test, deriveMultipleKeys) {
     EXPECT_TRUE(bufferUtils::equal(Hex::decode("56fa6aa75548099dcc37d7f03425e0c3"), dk));
 }
 
+TEST(Pbkdf2Test, sha256) {
+    // RFC 7914, section 11
+    crypto::Pbkdf<Sha256> kdf(crypto::Password(crypto::String("passwd")),
+                              crypto::Salt(crypto::String("salt")));
+    crypto::StaticBuffer<crypto::Byte, 64> dk(64);
+    kdf.derive(dk.size(), dk, 1);
+    const auto expected = Hex::decode("55ac046e56e3089fec1691c22544b605f94185216dde0465e68b9d57c20dacbc"
+                                      "49ca9cccf179b645991664b39d77ef317c71b845b1e30bd509112041d3a19783");
+    EXPECT_TRUE(bufferUtils::equal(expected, dk));
+
+    kdf.setPassword(crypto::Password(crypto::String("password")));
+    dk.resize(32);
+    kdf.derive(dk.size(), dk, 4096);
+    EXPECT_TRUE(bufferUtils::equal(
+        Hex::decode("c5e478d59288c841aa530db6845c4c8d962893a001ce4e11a4963873aa98134a"), dk));
+}
+
+TEST(Pbkdf2Test, md5) {
+    crypto::Pbkdf<Md5> kdf(crypto::Password(crypto::String("password")),
+                           crypto::Salt(crypto::String("salt")));
+    crypto::StaticBuffer<crypto::Byte, 40> dk(40);
+    kdf.derive(dk.size(), dk, 1000);
+    EXPECT_TRUE(bufferUtils::equal(
+        Hex::decode("8d189946a32d883622a16ae18af0632f5791d5e7b1abb0ab1757d28ce34056140335105994495f91"), dk));
+}
+
+TEST(Pbkdf2Test, sha512) {
+    // The 128 byte blocks of SHA-512 and an output longer than one digest
+    crypto::Pbkdf<Sha512> kdf(crypto::Password(crypto::String("password")),
+                              crypto::Salt(crypto::String("salt")));
+    crypto::StaticBuffer<crypto::Byte, 100> dk(100);
+    kdf.derive(dk.size(), dk, 2);
+    const auto expected = Hex::decode("e1d9c16aa681708a45f5c7c4e215ceb66e011a2e9f0040713f18aefdb866d53c"
+                                      "f76cab2868a39b9f7840edce4fef5a82be67335c77a6068e04112754f27ccf4e"
+                                      "473e311ad827b68945f4e2dddb204c78e40e2495141e411cd272d020640d673c"
+                                      "d34aa29f");
+    EXPECT_TRUE(bufferUtils::equal(expected, dk));
+}
+
+TEST(Pbkdf2Test, threads) {
+    // Five SHA-1 blocks, the last one partial
+    const auto expected = Hex::decode("3d2eec4fe41c849b80c8d83662c0e44a8b291a964cf2f07038b6b89a48612c5a"
+                                      "25284e6605e123296ec60ddb0cc22fb85e81dbde1e397d82fefe8c5c5b7fb1f9"
+                                      "3ff03beb5d7a49aab3f4da96922488bd27e6c3de2349f390d1f945");
+    for (crypto::Size threads : {0, 1, 2, 3, 5, 8}) {
+        crypto::Pbkdf2 kdf(crypto::Password(crypto::String("passwordPASSWORDpassword")),
+                           crypto::Salt(crypto::String("saltSALTsaltSALTsaltSALTsaltSALTsalt")));
+        kdf.setThreadCount(threads);
+        crypto::StaticBuffer<crypto::Byte, 91> dk(91);
+        kdf.derive(dk.size(), dk, 4096);
+        EXPECT_TRUE(bufferUtils::equal(expected, dk)) << threads;
+    }
+}
+
 } // namespace crypto
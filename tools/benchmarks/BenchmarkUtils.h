@@ -0,0 +1,71 @@
+#ifndef CPPLIBCRYPTO_BENCHMARKS_BENCHMARKUTILS_H_
+#define CPPLIBCRYPTO_BENCHMARKS_BENCHMARKUTILS_H_
+
+#include "cpplibcrypto/buffer/DynamicBuffer.h"
+#include "cpplibcrypto/common/common.h"
+
+#include <benchmark/benchmark.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace crypto {
+namespace benchmarks {
+
+/// The message sizes of the throughput benchmarks, 16 B to 16 MiB
+inline void messageSizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(16)->Range(16, 16 << 20);
+}
+
+/// Returns the deterministic pseudo-random test message of the given size
+inline ByteBuffer makeMessage(const Size size) {
+    ByteBuffer message(size);
+    Dword x = 0x12345678;
+    for (Size i = 0; i < size; ++i) {
+        x = x * 1103515245 + 12345;
+        message[i] = static_cast<Byte>(x >> 24);
+    }
+    return message;
+}
+
+/// Reads the time stamp counter, returns 0 where there is none
+inline Qword readCycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/// Measures the cycles spent in the benchmark loop and reports the throughput
+///
+/// Construct it right before the benchmark loop and call \ref finish() right after it. The time stamp
+/// counter ticks at the nominal frequency rather than the actual core clock, so cycles/byte are comparable
+/// between runs on the same machine, not across CPUs or with turbo boost in play.
+class Throughput {
+public:
+    explicit Throughput(benchmark::State& state)
+        : mState(state)
+        , mStart(readCycles()) {}
+
+    /// Reports bytes/second and cycles/byte, \p bytesPerIteration bytes being processed in every iteration
+    void finish(const Size bytesPerIteration) {
+        const Qword cycles = readCycles() - mStart;
+        const double bytes =
+            static_cast<double>(mState.iterations()) * static_cast<double>(bytesPerIteration);
+        mState.SetBytesProcessed(static_cast<std::int64_t>(bytes));
+        if (cycles != 0 && bytes != 0) {
+            mState.counters["cycles/byte"] = static_cast<double>(cycles) / bytes;
+        }
+    }
+
+private:
+    benchmark::State& mState;
+    Qword mStart;
+};
+
+} // namespace benchmarks
+} // namespace crypto
+
+#endif // CPPLIBCRYPTO_BENCHMARKS_BENCHMARKUTILS_H_
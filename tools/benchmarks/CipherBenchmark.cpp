@@ -0,0 +1,127 @@
+#include "BenchmarkUtils.h"
+
+#include "cpplibcrypto/buffer/BufferSlice.h"
+#include "cpplibcrypto/cipher/Aes.h"
+#include "cpplibcrypto/cipher/AesIv.h"
+#include "cpplibcrypto/cipher/CbcMode.h"
+
+namespace crypto {
+namespace benchmarks {
+
+namespace {
+
+    const AesKey& getKey(const Size keySize) {
+        static const AesKey key128(makeMessage(Aes::Aes128));
+        static const AesKey key192(makeMessage(Aes::Aes192));
+        static const AesKey key256(makeMessage(Aes::Aes256));
+        switch (keySize) {
+        case Aes::Aes128:
+            return key128;
+        case Aes::Aes192:
+            return key192;
+        }
+        return key256;
+    }
+
+    const char* getImplementationName(const Aes::Implementation implementation) {
+        switch (implementation) {
+        case Aes::Implementation::AesNi:
+            return "AES-NI";
+        case Aes::Implementation::Bitsliced:
+            return "bitsliced";
+        case Aes::Implementation::TTable:
+            break;
+        }
+        return "T-table";
+    }
+
+    /// Arguments: key size in bytes, message size, implementation
+    void aesArguments(benchmark::internal::Benchmark* b) {
+        for (const Aes::Implementation implementation :
+             { Aes::Implementation::AesNi, Aes::Implementation::Bitsliced, Aes::Implementation::TTable }) {
+            for (const Size keySize : { Aes::Aes128, Aes::Aes192, Aes::Aes256 }) {
+                for (Size size = 16; size <= (16 << 20); size *= 16) {
+                    b->Args({ std::int64_t(keySize), std::int64_t(size), std::int64_t(implementation) });
+                }
+            }
+        }
+        b->ArgNames({ "key", "size", "impl" });
+    }
+
+    /// Returns the cipher for the benchmark arguments or nothing if the implementation is not supported
+    bool makeAes(benchmark::State& state, Aes& aes) {
+        const auto implementation = static_cast<Aes::Implementation>(state.range(2));
+        if (!Aes::isSupported(implementation)) {
+            state.SkipWithError("Implementation not supported on this CPU");
+            return false;
+        }
+        aes = Aes(getKey(state.range(0)), implementation);
+        state.SetLabel(getImplementationName(implementation));
+        return true;
+    }
+
+} // namespace
+
+void aesEncrypt(benchmark::State& state) {
+    Aes aes;
+    if (!makeAes(state, aes)) {
+        return;
+    }
+    const Size size = state.range(1);
+    ByteBuffer data = makeMessage(size);
+    Throughput throughput(state);
+    for (auto _ : state) {
+        aes.encryptBlocks(data.data(), data.data(), size / aes.getBlockSize());
+        benchmark::DoNotOptimize(data.data());
+    }
+    throughput.finish(size);
+}
+BENCHMARK(aesEncrypt)->Apply(aesArguments);
+
+void aesDecrypt(benchmark::State& state) {
+    Aes aes;
+    if (!makeAes(state, aes)) {
+        return;
+    }
+    const Size size = state.range(1);
+    ByteBuffer data = makeMessage(size);
+    Throughput throughput(state);
+    for (auto _ : state) {
+        aes.decryptBlocks(data.data(), data.data(), size / aes.getBlockSize());
+        benchmark::DoNotOptimize(data.data());
+    }
+    throughput.finish(size);
+}
+BENCHMARK(aesDecrypt)->Apply(aesArguments);
+
+void cbcAesEncrypt(benchmark::State& state) {
+    const Size size = state.range(0);
+    CbcMode<Aes>::Encryption cipher(getKey(Aes::Aes256), AesIv(makeMessage(16)));
+    const ByteBuffer plaintext = makeMessage(size);
+    ByteBuffer ciphertext(size);
+    Throughput throughput(state);
+    for (auto _ : state) {
+        cipher.update(plaintext, BufferSlice<Byte>(ciphertext));
+        benchmark::DoNotOptimize(ciphertext.data());
+    }
+    throughput.finish(size);
+}
+BENCHMARK(cbcAesEncrypt)->Apply(messageSizes);
+
+void cbcAesDecrypt(benchmark::State& state) {
+    const Size size = state.range(0);
+    CbcMode<Aes>::Decryption cipher(getKey(Aes::Aes256), AesIv(makeMessage(16)));
+    const ByteBuffer ciphertext = makeMessage(size);
+    // The decryptor holds back the last block until the next update or finalization
+    ByteBuffer plaintext(size + 16);
+    Throughput throughput(state);
+    for (auto _ : state) {
+        cipher.update(ciphertext, BufferSlice<Byte>(plaintext));
+        benchmark::DoNotOptimize(plaintext.data());
+    }
+    throughput.finish(size);
+}
+BENCHMARK(cbcAesDecrypt)->Apply(messageSizes);
+
+} // namespace benchmarks
+} // namespace crypto
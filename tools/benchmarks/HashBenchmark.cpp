@@ -0,0 +1,75 @@
+#include "BenchmarkUtils.h"
+
+#include "cpplibcrypto/buffer/BufferSlice.h"
+#include "cpplibcrypto/buffer/StaticBuffer.h"
+#include "cpplibcrypto/hash/Hmac.h"
+#include "cpplibcrypto/hash/Md5.h"
+#include "cpplibcrypto/hash/Sha1.h"
+#include "cpplibcrypto/hash/Sha2.h"
+#include "cpplibcrypto/hash/TreeHash.h"
+
+namespace crypto {
+namespace benchmarks {
+
+template <typename THash>
+void hash(benchmark::State& state) {
+    const Size size = state.range(0);
+    const ByteBuffer message = makeMessage(size);
+    StaticBuffer<Byte, THash::DIGEST_SIZE> digest(THash::DIGEST_SIZE);
+    Throughput throughput(state);
+    for (auto _ : state) {
+        THash hasher;
+        hasher.update(message.data(), message.size());
+        hasher.finalize(digest);
+        benchmark::DoNotOptimize(digest.data());
+    }
+    throughput.finish(size);
+}
+BENCHMARK_TEMPLATE(hash, Md5)->Apply(messageSizes);
+BENCHMARK_TEMPLATE(hash, Sha1)->Apply(messageSizes);
+BENCHMARK_TEMPLATE(hash, Sha224)->Apply(messageSizes);
+BENCHMARK_TEMPLATE(hash, Sha256)->Apply(messageSizes);
+BENCHMARK_TEMPLATE(hash, Sha384)->Apply(messageSizes);
+BENCHMARK_TEMPLATE(hash, Sha512)->Apply(messageSizes);
+
+/// The second argument is the thread count, 0 for all the cores
+template <typename THash>
+void treeHash(benchmark::State& state) {
+    const Size size = state.range(0);
+    const ByteBuffer message = makeMessage(size);
+    StaticBuffer<Byte, THash::DIGEST_SIZE> root(THash::DIGEST_SIZE);
+    TreeHash<THash> tree;
+    tree.setThreadCount(state.range(1));
+    Throughput throughput(state);
+    for (auto _ : state) {
+        tree.update(message);
+        tree.finalize(root);
+        tree.reset();
+        benchmark::DoNotOptimize(root.data());
+    }
+    throughput.finish(size);
+}
+BENCHMARK_TEMPLATE(treeHash, Sha256)->Args({ 16 << 20, 1 })->Args({ 16 << 20, 0 })->UseRealTime();
+
+template <typename THash>
+void hmac(benchmark::State& state) {
+    const Size size = state.range(0);
+    const ByteBuffer message = makeMessage(size);
+    StaticBuffer<Byte, THash::DIGEST_SIZE> digest(THash::DIGEST_SIZE);
+    Hmac<THash> hmac(makeMessage(32));
+    Throughput throughput(state);
+    for (auto _ : state) {
+        hmac.update(BufferSlice<const Byte>(message));
+        hmac.finalize(digest);
+        hmac.reset();
+        benchmark::DoNotOptimize(digest.data());
+    }
+    throughput.finish(size);
+}
+BENCHMARK_TEMPLATE(hmac, Md5)->Apply(messageSizes);
+BENCHMARK_TEMPLATE(hmac, Sha1)->Apply(messageSizes);
+BENCHMARK_TEMPLATE(hmac, Sha256)->Apply(messageSizes);
+BENCHMARK_TEMPLATE(hmac, Sha512)->Apply(messageSizes);
+
+} // namespace benchmarks
+} // namespace crypto
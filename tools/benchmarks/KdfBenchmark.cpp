@@ -0,0 +1,37 @@
+#include "BenchmarkUtils.h"
+
+#include "cpplibcrypto/buffer/String.h"
+#include "cpplibcrypto/hash/Md5.h"
+#include "cpplibcrypto/hash/Sha1.h"
+#include "cpplibcrypto/hash/Sha2.h"
+#include "cpplibcrypto/kdf/Pbkdf.h"
+
+namespace crypto {
+namespace benchmarks {
+
+/// PBKDF2 cost is given by the iteration count rather than the message size. The argument is the derived
+/// key length, so the number of output blocks, at a fixed number of iterations. The reported bytes are those
+/// going through the HMAC compression function, two blocks per iteration and output block.
+template <typename THash>
+void pbkdf2(benchmark::State& state) {
+    constexpr Size ITERATIONS = 1000;
+    const Size length = state.range(0);
+    Pbkdf<THash> kdf(Password(String("password")), Salt(String("salt")));
+    ByteBuffer key(length);
+    Throughput throughput(state);
+    for (auto _ : state) {
+        kdf.derive(length, key, ITERATIONS);
+        benchmark::DoNotOptimize(key.data());
+    }
+    const Size outputBlocks = (length + THash::DIGEST_SIZE - 1) / THash::DIGEST_SIZE;
+    throughput.finish(2 * THash::BLOCK_SIZE * ITERATIONS * outputBlocks);
+    state.counters["iterations/s"] = benchmark::Counter(
+        static_cast<double>(ITERATIONS * outputBlocks), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK_TEMPLATE(pbkdf2, Md5)->Arg(16)->Arg(64);
+BENCHMARK_TEMPLATE(pbkdf2, Sha1)->Arg(20)->Arg(64);
+BENCHMARK_TEMPLATE(pbkdf2, Sha256)->Arg(32)->Arg(64);
+BENCHMARK_TEMPLATE(pbkdf2, Sha512)->Arg(64)->Arg(128);
+
+} // namespace benchmarks
+} // namespace crypto
@@ -8,6 +8,7 @@
 #include "cpplibcrypto/hash/Hmac.h"
 #include "cpplibcrypto/hash/Md5.h"
 #include "cpplibcrypto/hash/Sha1.h"
+#include "cpplibcrypto/io/FilePipeline.h"
 #include "cpplibcrypto/io/Stream.h"
 #include "cpplibcrypto/kdf/Pbkdf.h"
 #include "cpplibcrypto/padding/Pkcs7.h"
@@ -20,19 +21,7 @@ void encFile(Encryptor& encryptor,
              const crypto::String& outputFileName) {
     crypto::FileInputStream input(inputFileName);
     crypto::FileOutputStream output(outputFileName);
-    crypto::DynamicBuffer<crypto::Byte> cipherBuffer;
-
-    while (!input.eof()) {
-        crypto::StaticBuffer<crypto::Byte, 4096> plainBuffer(4096);
-        const crypto::Size read = input.read(plainBuffer.data(), plainBuffer.size());
-        plainBuffer.resize(read);
-        encryptor.update(plainBuffer, cipherBuffer);
-        output.write(cipherBuffer.data(), cipherBuffer.size());
-        cipherBuffer.clear();
-    }
-
-    encryptor.finalize(cipherBuffer, crypto::Pkcs7());
-    output.write(cipherBuffer.data(), cipherBuffer.size());
+    crypto::FilePipeline().run(input, encryptor, output, crypto::Pkcs7());
 }
 
 template <typename Decryptor>
@@ -41,19 +30,7 @@ void decFile(Decryptor& decryptor,
              const crypto::String& outputFileName) {
     crypto::FileInputStream input(inputFileName);
     crypto::FileOutputStream output(outputFileName);
-    crypto::DynamicBuffer<crypto::Byte> plainBuffer;
-
-    while (!input.eof()) {
-        crypto::StaticBuffer<crypto::Byte, 4096> cipherBuffer(4096);
-        const crypto::Size read = input.read(cipherBuffer.data(), cipherBuffer.capacity());
-        cipherBuffer.resize(read);
-        decryptor.update(cipherBuffer, plainBuffer);
-        output.write(plainBuffer.data(), plainBuffer.size());
-        plainBuffer.clear();
-    }
-
-    decryptor.finalize(plainBuffer, crypto::Pkcs7());
-    output.write(plainBuffer.data(), plainBuffer.size());
+    crypto::FilePipeline().run(input, decryptor, output, crypto::Pkcs7());
 }
 
 void sha1digest(const crypto::String& inputFileName) {